@@ -0,0 +1,83 @@
+// lookup_bench.c
+// Мікробенчмарк пошуку індексу гліфа за Unicode кодом:
+// старий лінійний прохід по cyr_map проти дворівневої таблиці UnicodeTable.
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+#include "UnicodeGlyphMap.h"
+#include "UnicodeTable.h"
+
+// Кількість проходів по тестовому рядку
+#define ITERATIONS 200000
+
+static int cyr_map_size = sizeof(cyr_map) / sizeof(cyr_map[0]);
+
+// Попередня реалізація: ASCII напряму, кирилиця — лінійний пошук
+static int LinearLookup(uint32_t codepoint) {
+    if (codepoint >= 32 && codepoint <= 126) return (int)codepoint;
+    for (int i = 0; i < cyr_map_size; i++) {
+        if (cyr_map[i].unicode == codepoint)
+            return cyr_map[i].glyph_index;
+    }
+    return 32;
+}
+
+static UnicodeTable table;
+
+// Нова реалізація: ASCII напряму, решта — пряма адресація
+static int TableLookup(uint32_t codepoint) {
+    if (codepoint >= 32 && codepoint <= 126) return (int)codepoint;
+    int glyph_index = UnicodeTable_Get(&table, codepoint);
+    return (glyph_index >= 0) ? glyph_index : 32;
+}
+
+static double Now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Вимірює кількість пошуків за секунду для функції lookup
+static double Measure(int (*lookup)(uint32_t), const uint32_t* text, int len, long* checksum) {
+    double start = Now();
+    long sum = 0;
+    for (int it = 0; it < ITERATIONS; it++) {
+        for (int i = 0; i < len; i++) {
+            sum += lookup(text[i]);
+        }
+    }
+    double elapsed = Now() - start;
+    *checksum = sum;
+    return (double)ITERATIONS * len / elapsed;
+}
+
+int main(void) {
+    // Типовий рядок інтерфейсу осцилографа (кодові точки)
+    static const uint32_t text[] = {
+        0x041C, 0x0430, 0x0441, 0x0448, 0x0442, 0x0430, 0x0431, 0x043E, 0x0432, 0x0430,
+        0x043D, 0x0438, 0x0439, ' ', 0x0442, 0x0435, 0x043A, 0x0441, 0x0442, ' ',
+        0x0437, ' ', 0x0456, 0x043D, 0x0432, 0x0435, 0x0440, 0x0441, 0x043D, 0x0438,
+        0x043C, ' ', 0x0444, 0x043E, 0x043D, 0x043E, 0x043C, ' ', '1', '0', '0', ' ',
+        0x043C, 0x0412, '/', 0x0434, 0x0456, 0x0432, ' ', 0x0491, 0x0457, 0x0454, 0x042F
+    };
+    int len = sizeof(text) / sizeof(text[0]);
+
+    UnicodeTable_Init(&table);
+    for (uint32_t c = 32; c <= 126; c++) UnicodeTable_Set(&table, c, (int)c);
+    for (int i = 0; i < cyr_map_size; i++) UnicodeTable_Set(&table, cyr_map[i].unicode, cyr_map[i].glyph_index);
+
+    long sumLinear = 0, sumTable = 0;
+    double linear = Measure(LinearLookup, text, len, &sumLinear);
+    double direct = Measure(TableLookup, text, len, &sumTable);
+
+    printf("cyr_map: %d записів, рядок: %d символів\n", cyr_map_size, len);
+    printf("лінійний пошук:  %12.0f пошуків/с\n", linear);
+    printf("UnicodeTable:    %12.0f пошуків/с (x%.1f)\n", direct, direct / linear);
+    if (sumLinear != sumTable) {
+        printf("ПОМИЛКА: результати пошуку відрізняються (%ld != %ld)\n", sumLinear, sumTable);
+        return 1;
+    }
+
+    UnicodeTable_Free(&table);
+    return 0;
+}
@@ -0,0 +1,167 @@
+// raster_bench.c
+// Мікробенчмарк растеризації гліфів: побітовий розбір байтів, рядкові маски uint64_t
+// і розклад на прямокутники, повернутий текст, стиснуті в пам’яті гліфи, кеш розкладених рядків і підготовлений текст. Замість виводу на екран виклики лише підраховуються,
+// тому вимірюється саме обхід гліфів і кількість викликів бекенда.
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+#include "psf_font.h"
+
+// Кількість проходів по тестовому рядку
+#define ITERATIONS 20000
+
+static const char* sample = "The quick brown fox jumps over the lazy dog 0123456789 "
+                            "Швидка бура лисиця перестрибує через лінивого пса";
+
+static volatile long g_calls;   // Кількість викликів виводу
+static volatile long g_area;    // Сумарна залита площа (для перевірки однаковості результату)
+
+// Підміна функцій виводу графічної бібліотеки: лише лічильники
+void DrawPixel(uint16_t x, uint16_t y, uint32_t color) {
+    (void)x; (void)y; (void)color;
+    g_calls++;
+    g_area++;
+}
+
+void DrawRectangle(int16_t x, int16_t y, int16_t width, int16_t height, uint32_t color) {
+    (void)x; (void)y; (void)color;
+    g_calls++;
+    g_area += width * height;
+}
+
+static double Now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Вимірює кількість намальованих символів за секунду (rotation — кут повороту тексту)
+static double Measure(PSF_Font font, int scale, int rotation, long* area, long* calls) {
+    int chars = utf8_strlen(sample);
+    g_calls = 0;
+    g_area = 0;
+    double start = Now();
+    for (int i = 0; i < ITERATIONS; i++) {
+        if (rotation) DrawPSFTextRotatedScaled(font, 0, 0, sample, 1, rotation, scale, 0xFFFFFF);
+        else DrawPSFTextScaled(font, 0, 0, sample, 1, scale, 0xFFFFFF);
+    }
+    double elapsed = Now() - start;
+    *area = g_area;
+    *calls = g_calls / ITERATIONS;
+    return (double)chars * ITERATIONS / elapsed;
+}
+
+int main(int argc, char* argv[]) {
+    const char* filename = argc > 1 ? argv[1] : "../psf_font-scale-gfx/fonts/Uni3-Terminus32x16.psf";
+    PSF_Font font = LoadPSFFont(filename);
+
+    // Розклад на прямокутники будуємо одразу, але для порівняння тимчасово відключаємо його
+    BuildPSFGlyphRects(&font);
+    PSF_GlyphRect* glyphRects = font.glyphRects;
+    font.glyphRects = NULL;
+
+    for (int scale = 1; scale <= 2; scale++) {
+        long byteArea, maskArea, rectArea;
+        long byteCalls, maskCalls, rectCalls;
+        double bytes = Measure(font, scale, 0, &byteArea, &byteCalls);
+        BuildPSFRowMasks(&font);
+        double masks = Measure(font, scale, 0, &maskArea, &maskCalls);
+        font.glyphRects = glyphRects;
+        double rects = Measure(font, scale, 0, &rectArea, &rectCalls);
+
+        printf("%s, scale %d:\n", filename, scale);
+        printf("  побітово:        %12.0f символів/с  %6ld викликів на рядок\n", bytes, byteCalls);
+        printf("  маски uint64_t:  %12.0f символів/с  %6ld викликів на рядок  (x%.1f)\n",
+               masks, maskCalls, masks / bytes);
+        printf("  прямокутники:    %12.0f символів/с  %6ld викликів на рядок  (x%.1f)\n",
+               rects, rectCalls, rects / bytes);
+        if (byteArea != maskArea || byteArea != rectArea) {
+            printf("  ПОМИЛКА: різна залита площа (%ld, %ld, %ld)\n", byteArea, maskArea, rectArea);
+            return 1;
+        }
+
+        // Повертаємось до побітового шляху для наступного масштабу
+        free(font.rowMasks);
+        font.rowMasks = NULL;
+        font.glyphRects = NULL;
+    }
+
+    font.glyphRects = glyphRects;
+
+    // Повернутий текст малюється з повернутої копії шрифту тим самим шляхом
+    long flatArea, rotatedArea, flatCalls, rotatedCalls;
+    double flat = Measure(font, 1, 0, &flatArea, &flatCalls);
+    GetPSFRotatedFont(&font, 90);  // Копія будується один раз, поза вимірюванням
+    double rotated = Measure(font, 1, 90, &rotatedArea, &rotatedCalls);
+    printf("%s, поворот на 90°:\n", filename);
+    printf("  горизонтально:   %12.0f символів/с  %6ld викликів на рядок\n", flat, flatCalls);
+    printf("  повернуто:       %12.0f символів/с  %6ld викликів на рядок  (x%.2f)\n",
+           rotated, rotatedCalls, rotated / flat);
+    if (flatArea != rotatedArea) {
+        printf("  ПОМИЛКА: різна залита площа (%ld, %ld)\n", flatArea, rotatedArea);
+        return 1;
+    }
+
+    // Стиснуті в пам’яті гліфи малюються побітовим шляхом через кеш розпакованих гліфів
+    PSF_Font compressed = LoadPSFFont(filename);
+    if (CompressPSFFont(&compressed, 0)) {
+        font.glyphRects = NULL;
+        long rawArea, packedArea, rawCalls, packedCalls;
+        double raw = Measure(font, 1, 0, &rawArea, &rawCalls);
+        double packed = Measure(compressed, 1, 0, &packedArea, &packedCalls);
+        GlyphCompressorStats stats;
+        GlyphCompressor_GetStats(compressed.compressor, &stats);
+        printf("%s, стиснення гліфів у пам’яті:\n", filename);
+        printf("  гліфи:           %8zu байтів -> %zu + кеш %zu (x%.1f), словник %d рядків\n",
+               stats.rawBytes, stats.compressedBytes, stats.cacheBytes,
+               (double)stats.rawBytes / (stats.compressedBytes + stats.cacheBytes), stats.dictionaryRows);
+        printf("  побітово:        %12.0f символів/с\n", raw);
+        printf("  стиснуті:        %12.0f символів/с  (x%.2f), розпаковано %lu гліфів, з кешу %lu\n",
+               packed, packed / raw, stats.decodes, stats.hits);
+        font.glyphRects = glyphRects;
+        if (rawArea != packedArea) {
+            printf("  ПОМИЛКА: різна залита площа (%ld, %ld)\n", rawArea, packedArea);
+            return 1;
+        }
+    }
+    UnloadPSFFont(compressed);
+
+    // Той самий рядок щокадру: декодування і розкладка на кожен виклик (копію шрифту без serial
+    // кеш не обслуговує), кеш розкладених рядків і підготовлений текст
+    {
+        PSF_Font uncached = font;
+        uncached.serial = 0;
+        long textArea = 0, textCalls = 0;
+        double text = Measure(uncached, 1, 0, &textArea, &textCalls);
+        long cachedArea = 0, cachedCalls = 0;
+        double cached = Measure(font, 1, 0, &cachedArea, &cachedCalls);
+        PSF_TextRunCacheStats stats;
+        GetPSFTextRunCacheStats(&stats);
+
+        PSF_PreparedText* prepared = PreparePSFText(&font, sample, 1, 1);
+        int chars = utf8_strlen(sample);
+        g_calls = 0;
+        g_area = 0;
+        double start = Now();
+        for (int i = 0; i < ITERATIONS; i++) {
+            DrawPreparedPSFText(prepared, 0, 0, 0xFFFFFF);
+        }
+        double ready = (double)chars * ITERATIONS / (Now() - start);
+        long readyArea = g_area;
+        FreePreparedPSFText(prepared);
+
+        printf("%s, той самий рядок щокадру:\n", filename);
+        printf("  без кешу:        %12.0f символів/с\n", text);
+        printf("  кеш рядків:      %12.0f символів/с  (x%.2f), влучань %lu, промахів %lu\n",
+               cached, cached / text, stats.hits, stats.misses);
+        printf("  підготовлений:   %12.0f символів/с  (x%.2f)\n", ready, ready / text);
+        if (textArea != cachedArea || textArea != readyArea) {
+            printf("  ПОМИЛКА: різна залита площа (%ld, %ld, %ld)\n", textArea, cachedArea, readyArea);
+            return 1;
+        }
+    }
+
+    UnloadPSFFont(font);
+    return 0;
+}
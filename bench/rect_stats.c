@@ -0,0 +1,55 @@
+// rect_stats.c
+// Статистика розкладу гліфів на прямокутники для шрифтів з командного рядка:
+// скільки заливок прямокутника потрібно на гліф замість одного виклику на кожен піксель.
+#include <stdio.h>
+#include <string.h>
+#include "psf_font.h"
+
+// Функції виводу графічної бібліотеки не використовуються, але потрібні компонувальнику
+void DrawPixel(uint16_t x, uint16_t y, uint32_t color) { (void)x; (void)y; (void)color; }
+void DrawRectangle(int16_t x, int16_t y, int16_t width, int16_t height, uint32_t color) {
+    (void)x; (void)y; (void)width; (void)height; (void)color;
+}
+
+// Кількість увімкнених пікселів гліфа
+static int CountPixels(const PSF_Font* font, int c) {
+    int count = 0;
+    int n = 0;
+    const PSF_GlyphRect* rects = GetPSFGlyphRects(font, c, &n);
+    for (int i = 0; i < n; i++) count += rects[i].w * rects[i].h;
+    return count;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        printf("Використання: %s font1.psf [font2.psf ...]\n", argv[0]);
+        return 1;
+    }
+
+    // Ширини колонок як у рядках нижче (printf рахує байти, а не символи кирилиці)
+    printf("%s\n", "шрифт                        прямок./гліф   макс   пікс./гліф   викликів");
+    for (int f = 1; f < argc; f++) {
+        PSF_Font font = LoadPSFFont(argv[f]);
+        BuildPSFGlyphRects(&font);
+        long rects = 0, pixels = 0;
+        int inked = 0, maxRects = 0;
+
+        for (int c = 0; c < font.charcount; c++) {
+            int n = 0;
+            if (!GetPSFGlyphRects(&font, c, &n) || n == 0) continue; // Порожні гліфи не малюються
+            inked++;
+            rects += n;
+            pixels += CountPixels(&font, c);
+            if (n > maxRects) maxRects = n;
+        }
+
+        const char* name = strrchr(argv[f], '/');
+        name = name ? name + 1 : argv[f];
+        if (inked && rects) {
+            printf("%-28s %12.1f %6d %12.1f %9.1fx\n", name, (double)rects / inked, maxRects,
+                   (double)pixels / inked, (double)pixels / rects);
+        }
+        UnloadPSFFont(font);
+    }
+    return 0;
+}
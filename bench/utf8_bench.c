@@ -0,0 +1,103 @@
+// utf8_bench.c
+// Мікробенчмарк декодування UTF-8: попередній utf8_decode по символу за виклик
+// проти пакетного Utf8Decoder_Decode (ASCII блоками SSE2/AVX2, перевірка коректності).
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include "Utf8Decoder.h"
+
+// Кількість проходів по тексту
+#define ITERATIONS 20000
+
+// Довжина тексту для вимірювання (рядок-зразок повторюється)
+#define TEXT_BYTES 4096
+
+// Попередня реалізація: без перевірки байтів продовження
+static int OldDecode(const char* str, uint32_t* out_codepoint) {
+    unsigned char c = (unsigned char)str[0];
+    if (c < 0x80) {
+        *out_codepoint = c;
+        return 1;
+    } else if ((c & 0xE0) == 0xC0) {
+        *out_codepoint = ((str[0] & 0x1F) << 6) | (str[1] & 0x3F);
+        return 2;
+    } else if ((c & 0xF0) == 0xE0) {
+        *out_codepoint = ((str[0] & 0x0F) << 12) | ((str[1] & 0x3F) << 6) | (str[2] & 0x3F);
+        return 3;
+    } else if ((c & 0xF8) == 0xF0) {
+        *out_codepoint = ((str[0] & 0x07) << 18) | ((str[1] & 0x3F) << 12) | ((str[2] & 0x3F) << 6) | (str[3] & 0x3F);
+        return 4;
+    }
+    *out_codepoint = 0;
+    return 1;
+}
+
+static double Now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static uint32_t codepoints[TEXT_BYTES];
+
+static uint64_t Checksum(size_t count) {
+    uint64_t sum = 0;
+    for (size_t i = 0; i < count; i++) sum = sum * 31 + codepoints[i];
+    return sum;
+}
+
+// Мегабайтів за секунду для попереднього декодування в масив символ за символом
+static double MeasureOld(const char* text, size_t length, uint64_t* checksum) {
+    size_t count = 0;
+    double start = Now();
+    for (int it = 0; it < ITERATIONS; it++) {
+        const char* p = text;
+        count = 0;
+        while (*p) p += OldDecode(p, &codepoints[count++]);
+    }
+    double elapsed = Now() - start;
+    *checksum = Checksum(count);
+    return (double)ITERATIONS * length / elapsed / 1e6;
+}
+
+// Мегабайтів за секунду для пакетного декодування в масив
+static double MeasureBatch(const char* text, size_t length, uint64_t* checksum) {
+    size_t count = 0;
+    double start = Now();
+    for (int it = 0; it < ITERATIONS; it++) {
+        count = Utf8Decoder_Decode(text, length, codepoints, TEXT_BYTES, NULL);
+    }
+    double elapsed = Now() - start;
+    *checksum = Checksum(count);
+    return (double)ITERATIONS * length / elapsed / 1e6;
+}
+
+static int Run(const char* name, const char* sample) {
+    static char text[TEXT_BYTES + 1];
+    size_t sampleLength = strlen(sample);
+    size_t length = 0;
+    while (length + sampleLength <= TEXT_BYTES) {
+        memcpy(text + length, sample, sampleLength);
+        length += sampleLength;
+    }
+    text[length] = '\0';
+
+    uint64_t sumOld = 0, sumBatch = 0;
+    double old = MeasureOld(text, length, &sumOld);
+    double batch = MeasureBatch(text, length, &sumBatch);
+    printf("%-10s utf8_decode: %8.0f МБ/с   Utf8Decoder: %8.0f МБ/с (x%.1f)\n", name, old, batch, batch / old);
+    if (sumOld != sumBatch) {
+        printf("ПОМИЛКА: результати декодування відрізняються\n");
+        return 1;
+    }
+    return 0;
+}
+
+int main(void) {
+    int failed = 0;
+    failed |= Run("ASCII", "CH1: 100 mV/div, CH2: 2.00 V/div, Timebase 10 us/div, Trigger: rising edge. ");
+    failed |= Run("кирилиця", "Масштаб каналу, розгортка, синхронізація за фронтом — налаштування. ");
+    failed |= Run("змішаний", "Канал 1: 100 мВ/под, розгортка 10 мкс, Trigger: фронт ↑ 1,25 В. ");
+    return failed;
+}
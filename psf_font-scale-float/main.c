@@ -2,6 +2,7 @@
 #include "raylib.h"
 #include "psf_font.h"
 #include "GlyphCache.h"
+#include "EmbeddedFonts.h"
 #include "draw.h"
 
 PSF_Font font12;
@@ -11,9 +12,9 @@ PSF_Font font32;
 int main(void) {
     InitWindow(800, 450, "PSF Font with Multi-Font Glyph Cache");
 
-    font12 = LoadPSFFont("fonts/Uni3-Terminus12x6.psf");
-    font18 = LoadPSFFont("fonts/Uni3-TerminusBold18x10.psf");
-    font32 = LoadPSFFont("fonts/Uni3-TerminusBold32x16.psf");
+    font12 = LoadPSFFontEmbedded("fonts/Uni3-Terminus12x6.psf");
+    font18 = LoadPSFFontEmbedded("fonts/Uni3-TerminusBold18x10.psf");
+    font32 = LoadPSFFontEmbedded("fonts/Uni3-TerminusBold32x16.psf");
 
     SetTargetFPS(60);
 
@@ -0,0 +1,73 @@
+// EmbeddedFonts.c
+// Шрифти, вбудовані у виконуваний файл ціллю EMBED_FONTS=1 у Makefile
+#include "EmbeddedFonts.h"
+#include <string.h>
+
+// Перелік шрифтів з каталогу fonts/: ім’я файлу та ім’я символу,
+// яке для нього створює `ld -r -b binary fonts/<файл>.psf` ('-' замінюється на '_')
+#define EMBEDDED_FONT_LIST(X) \
+    X("Uni3-Terminus12x6",      Uni3_Terminus12x6) \
+    X("Uni3-Terminus18x10",     Uni3_Terminus18x10) \
+    X("Uni3-Terminus20x10",     Uni3_Terminus20x10) \
+    X("Uni3-Terminus22x11",     Uni3_Terminus22x11) \
+    X("Uni3-Terminus24x12",     Uni3_Terminus24x12) \
+    X("Uni3-Terminus28x14",     Uni3_Terminus28x14) \
+    X("Uni3-Terminus32x16",     Uni3_Terminus32x16) \
+    X("Uni3-TerminusBold18x10", Uni3_TerminusBold18x10) \
+    X("Uni3-TerminusBold20x10", Uni3_TerminusBold20x10) \
+    X("Uni3-TerminusBold22x11", Uni3_TerminusBold22x11) \
+    X("Uni3-TerminusBold24x12", Uni3_TerminusBold24x12) \
+    X("Uni3-TerminusBold28x14", Uni3_TerminusBold28x14) \
+    X("Uni3-TerminusBold32x16", Uni3_TerminusBold32x16)
+
+// Опис одного вбудованого файлу
+typedef struct {
+    const char* filename;        // Шлях, під яким шрифт шукають (як для LoadPSFFont)
+    const unsigned char* start;  // Початок даних файлу
+    const unsigned char* end;    // Кінець даних файлу
+} EmbeddedFont;
+
+#ifdef PSF_EMBEDDED_FONTS
+
+#define EMBEDDED_FONT_DECLARE(file, sym) \
+    extern const unsigned char _binary_fonts_##sym##_psf_start[]; \
+    extern const unsigned char _binary_fonts_##sym##_psf_end[];
+EMBEDDED_FONT_LIST(EMBEDDED_FONT_DECLARE)
+
+#define EMBEDDED_FONT_ENTRY(file, sym) \
+    { "fonts/" file ".psf", _binary_fonts_##sym##_psf_start, _binary_fonts_##sym##_psf_end },
+static const EmbeddedFont embedded_fonts[] = {
+    EMBEDDED_FONT_LIST(EMBEDDED_FONT_ENTRY)
+};
+static const int embedded_font_count = sizeof(embedded_fonts) / sizeof(embedded_fonts[0]);
+
+#else
+
+// Звичайна збірка: шрифти читаються з файлів
+static const EmbeddedFont* embedded_fonts = NULL;
+static const int embedded_font_count = 0;
+
+#endif // PSF_EMBEDDED_FONTS
+
+int FindEmbeddedPSF(const char* filename, const void** data, size_t* size) {
+    // Дозволяємо шлях з префіксом "./"
+    if (strncmp(filename, "./", 2) == 0) filename += 2;
+
+    for (int i = 0; i < embedded_font_count; i++) {
+        if (strcmp(embedded_fonts[i].filename, filename) == 0) {
+            *data = embedded_fonts[i].start;
+            *size = (size_t)(embedded_fonts[i].end - embedded_fonts[i].start);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+PSF_Font LoadPSFFontEmbedded(const char* filename) {
+    const void* data = NULL;
+    size_t size = 0;
+    if (FindEmbeddedPSF(filename, &data, &size)) {
+        return LoadPSFFontFromMemory(data, size);
+    }
+    return LoadPSFFont(filename);
+}
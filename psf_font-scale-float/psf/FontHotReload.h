@@ -0,0 +1,28 @@
+// FontHotReload.h
+#ifndef FONT_HOT_RELOAD_H
+#define FONT_HOT_RELOAD_H
+
+#include "FontRegistry.h"
+
+// Стежить через inotify за файлами шрифтів реєстру і перезавантажує змінений шрифт на місці.
+// Файл читається й розбирається у фоновому потоці; кадр лише підміняє готові дані
+// у FontHotReload_Poll, а кеші скидають тільки ті гліфи, чиї біти змінилися.
+typedef struct FontHotReload FontHotReload;
+
+// Створює спостерігач і його потік; NULL, якщо inotify недоступний
+FontHotReload* FontHotReload_Create(void);
+
+// Додає шрифт реєстру до спостереження (за шляхом, з яким його завантажено
+// FontRegistry_Load). Стежимо за каталогом, тож збереження через перейменування
+// тимчасового файлу (як роблять редактори) теж помічається. Повертає 1 при успіху.
+int FontHotReload_Watch(FontHotReload* reload, FontHandle handle);
+
+// Викликається раз за кадр з потоку, що малює: застосовує готові перезавантаження.
+// Не чекає на фоновий потік (якщо той саме зайнятий — застосування переноситься
+// на наступний кадр). Повертає кількість перезавантажених шрифтів.
+int FontHotReload_Poll(FontHotReload* reload);
+
+// Зупиняє потік і звільняє ще не застосовані версії шрифтів
+void FontHotReload_Destroy(FontHotReload* reload);
+
+#endif // FONT_HOT_RELOAD_H
@@ -79,11 +79,48 @@ void DrawPSFCharScaledTexture(Texture2D tex, int x, int y, float scale, Color co
     DrawTexturePro(tex, sourceRec, destRec, origin, 0.0f, color);
 }
 
-// Внутрішня функція пошуку кешу для конкретного шрифту за унікальним вказівником на glyphBuffer
+// Звільняє кеш шрифту (обробник UnloadPSFFont): текстури не переживають шрифт,
+// а місце в таблиці кешів звільняється для наступних шрифтів
+void GlyphCache_ForgetFont(const PSF_Font* font) {
+    for (int i = 0; i < g_fontCacheCount; i++) {
+        if (g_fontCaches[i].font.serial == font->serial) {
+            GlyphCache_Unload(&g_fontCaches[i].cache);
+            g_fontCaches[i] = g_fontCaches[--g_fontCacheCount];
+            return;
+        }
+    }
+}
+
+// Скидає текстуру гліфа, зміненого при перезавантаженні шрифту (обробник ReloadPSFFontInPlace):
+// текстура буде створена заново з нових даних при наступному малюванні, решта кешу лишається
+void GlyphCache_GlyphChanged(const PSF_Font* font, int glyphIndex) {
+    for (int i = 0; i < g_fontCacheCount; i++) {
+        if (g_fontCaches[i].font.serial != font->serial) continue;
+
+        GlyphCache* cache = &g_fontCaches[i].cache;
+        g_fontCaches[i].font = *font;
+        if (glyphIndex >= 0 && glyphIndex < cache->charcount && cache->glyphTextures[glyphIndex].id != 0) {
+            UnloadTexture(cache->glyphTextures[glyphIndex]);
+            cache->glyphTextures[glyphIndex].id = 0;
+        }
+        return;
+    }
+}
+
+// Внутрішня функція пошуку кешу для конкретного шрифту за номером завантаження font.serial.
+// Вказівник glyphBuffer для цього не годиться: після звільнення шрифту malloc/mmap можуть
+// повернути ту саму адресу новому шрифту, і той отримав би чужі текстури.
 static GlyphCache* GetCacheForFont(PSF_Font font) {
+    // Кеш звільняється разом зі шрифтом і оновлюється при його перезавантаженні
+    static int hooksAdded = 0;
+    if (!hooksAdded) {
+        hooksAdded = AddPSFUnloadHook(GlyphCache_ForgetFont) &&
+                     AddPSFGlyphChangedHook(GlyphCache_GlyphChanged);
+    }
+
     // Перевіряємо, чи кеш для цього шрифту вже існує
     for (int i = 0; i < g_fontCacheCount; i++) {
-        if (g_fontCaches[i].font.glyphBuffer == font.glyphBuffer) {
+        if (g_fontCaches[i].font.serial == font.serial) {
             // Знайшли існуючий кеш — повертаємо його
             return &g_fontCaches[i].cache;
         }
@@ -102,46 +139,205 @@ static GlyphCache* GetCacheForFont(PSF_Font font) {
     return NULL;
 }
 
-// Малює UTF-8 текст шрифтом PSF з динамічним кешем гліфів,
-// підтримує багатошрифтовість і різні кольори
-void DrawPSFText(PSF_Font font, int x, int y, const char* text, int spacing, float scale, Color color) {
+// Малює текст з курсора (UTF-8, UTF-32 або готові індекси гліфів): розкладка і пошук гліфів —
+// за шрифтом font, текстури — з кешу шрифту glyphs (сам font або його стилізована копія,
+// зсунута на pad пікселів вліво-вгору)
+static void DrawPSFTextWithGlyphs(PSF_Font font, const PSF_Font* glyphs, int pad, int x, int y,
+                                  PSF_TextCursor* cursor, int spacing, float scale, Color color) {
     // Отримуємо кеш для заданого шрифту
-    GlyphCache* cache = GetCacheForFont(font);
+    GlyphCache* cache = GetCacheForFont(*glyphs);
     if (!cache) return; // Якщо кеш не створено — нічого не малюємо
 
     int xpos = x;
     int ypos = y;
 
-    while (*text) {
+    int glyph_index;
+    while ((glyph_index = NextPSFTextItem(cursor)) != PSF_TEXT_END) {
         // Обробка символу нового рядка
-        if (*text == '\n') {
+        if (glyph_index == PSF_TEXT_NEWLINE) {
             xpos = x; // повертаємось у початок рядка
             ypos += (int)((font.height * scale) + spacing); // переходимо на наступний рядок
-            text++;
             continue;
         }
 
-        uint32_t codepoint = 0;
-        // Декодуємо один UTF-8 символ і отримуємо Unicode код
-        int bytes = utf8_decode(text, &codepoint);
-
-        // Знаходимо індекс гліфа для Unicode коду
-        int glyph_index = UnicodeToGlyphIndex(codepoint);
-
         // Якщо індекс некоректний — замінюємо на пробіл
         if (glyph_index < 0 || glyph_index >= font.charcount) glyph_index = 32;
 
-        // Отримуємо текстуру гліфа з кешу (монохромну)
-        Texture2D glyphTex = GlyphCache_GetTexture(cache, font, glyph_index, scale);
+        // Порожній гліф (пробіл) не потребує ні текстури, ні малювання
+        const PSF_GlyphBounds* bounds = GetPSFGlyphBounds(glyphs, glyph_index);
+        if (!bounds || !bounds->isEmpty) {
+            // Отримуємо текстуру гліфа з кешу (монохромну, лише межі «чорнила»)
+            Texture2D glyphTex = GlyphCache_GetTexture(cache, *glyphs, glyph_index, scale);
 
-        // Малюємо текстуру гліфа з потрібним кольором
-        DrawPSFCharScaledTexture(glyphTex, xpos, ypos, scale, color);
+            // Малюємо текстуру гліфа з потрібним кольором, зсунувши її на межі «чорнила»
+            int offsetX = (int)(((bounds ? bounds->firstCol : 0) - pad) * scale);
+            int offsetY = (int)(((bounds ? bounds->firstRow : 0) - pad) * scale);
+            DrawPSFCharScaledTexture(glyphTex, xpos + offsetX, ypos + offsetY, scale, color);
+        }
 
         // Зсуваємо позицію по горизонталі для наступного символу
         xpos += (int)((font.width * scale) + spacing);
+    }
+}
+
+// Вивід гліфів розкладки шрифтом font: кеш текстур шукається один раз на виклик,
+// гліф — текстура з кешу за готовою позицією (розкладки кешу рядків шрифту не зберігають)
+static void DrawPSFTextRun(const PSF_Font* font, const PSF_PreparedText* text, int x, int y, Color color) {
+    GlyphCache* cache = GetCacheForFont(*font);
+    if (!cache) return;
+
+    for (int i = 0; i < text->glyphCount; i++) {
+        const PSF_PreparedGlyph* g = &text->glyphs[i];
+        Texture2D glyphTex = { 0 };
+        if (g->glyph < cache->charcount) glyphTex = cache->glyphTextures[g->glyph];
+        if (glyphTex.id == 0) glyphTex = GlyphCache_GetTexture(cache, *font, g->glyph, text->scale);
+        DrawPSFCharScaledTexture(glyphTex, x + g->x, y + g->y, text->scale, color);
+    }
+}
+
+// Малює UTF-8 текст шрифтом PSF з динамічним кешем гліфів,
+// підтримує багатошрифтовість і різні кольори
+void DrawPSFText(PSF_Font font, int x, int y, const char* text, int spacing, float scale, Color color) {
+    // Той самий рядок щокадру — готова розкладка з кешу (GetPSFTextRun), без декодування
+    const PSF_PreparedText* run = GetPSFTextRun(&font, text, spacing, scale);
+    if (run) {
+        DrawPSFTextRun(&font, run, x, y, color);
+        return;
+    }
+    PSF_TextCursor cursor;
+    InitPSFTextCursor(&cursor, &font, text);
+    DrawPSFTextWithGlyphs(font, &font, 0, x, y, &cursor, spacing, scale, color);
+}
+
+// Варіанти без завершального нуля і без повторного декодування (не проходять через кеш розкладок)
+void DrawPSFTextN(PSF_Font font, int x, int y, const char* text, size_t length, int spacing, float scale, Color color) {
+    PSF_TextCursor cursor;
+    InitPSFTextCursorN(&cursor, &font, text, length);
+    DrawPSFTextWithGlyphs(font, &font, 0, x, y, &cursor, spacing, scale, color);
+}
+
+void DrawPSFTextUTF32(PSF_Font font, int x, int y, const uint32_t* codepoints, size_t count, int spacing, float scale, Color color) {
+    PSF_TextCursor cursor;
+    InitPSFTextCursorUTF32(&cursor, &font, codepoints, count);
+    DrawPSFTextWithGlyphs(font, &font, 0, x, y, &cursor, spacing, scale, color);
+}
+
+void DrawPSFGlyphs(PSF_Font font, int x, int y, const int32_t* glyphs, size_t count, int spacing, float scale, Color color) {
+    PSF_TextCursor cursor;
+    InitPSFTextCursorGlyphs(&cursor, glyphs, count);
+    DrawPSFTextWithGlyphs(font, &font, 0, x, y, &cursor, spacing, scale, color);
+}
+
+// Малює підготовлений текст (PreparePSFText) шрифтом, для якого його розкладено
+void DrawPreparedPSFText(const PSF_PreparedText* text, int x, int y, Color color) {
+    if (!text || !text->font) return;
+    DrawPSFTextRun(text->font, text, x, y, color);
+}
+
+// Малює UTF-8 текст ланцюжком запасних шрифтів: пара (шрифт, гліф) береться з кешу ланцюжка,
+// текстура — з кешу того шрифту, що має гліф (кеш шукається лише при зміні шрифту між символами).
+// Висоту рядка задає основний шрифт; гліф іншої висоти центрується в рядку.
+void DrawPSFTextFallback(FontFallback* fallback, int x, int y, const char* text, int spacing, float scale, Color color) {
+    const PSF_Font* primary = FontFallback_GetPrimary(fallback);
+    if (!primary) return;
+    FontFallback_Revalidate(fallback);
+
+    const PSF_Font* cachedFont = NULL;
+    GlyphCache* cache = NULL;
+    int xpos = x;
+    int ypos = y;
+
+    PSF_TextCursor cursor;
+    InitPSFTextCursor(&cursor, NULL, text);
+    int codepoint;
+    while ((codepoint = NextPSFTextItem(&cursor)) != PSF_TEXT_END) {
+        if (codepoint == PSF_TEXT_NEWLINE) {
+            xpos = x;
+            ypos += (int)((primary->height * scale) + spacing);
+            continue;
+        }
+
+        FontFallbackGlyph g = FontFallback_Resolve(fallback, codepoint);
+        if (g.font != cachedFont) {
+            cachedFont = g.font;
+            cache = GetCacheForFont(*g.font);
+        }
+
+        const PSF_GlyphBounds* bounds = GetPSFGlyphBounds(g.font, g.glyph);
+        if (cache && (!bounds || !bounds->isEmpty)) {
+            Texture2D glyphTex = GlyphCache_GetTexture(cache, *g.font, g.glyph, scale);
+            int offsetX = (int)((bounds ? bounds->firstCol : 0) * scale);
+            int offsetY = (int)(((bounds ? bounds->firstRow : 0) + (primary->height - g.font->height) / 2) * scale);
+            DrawPSFCharScaledTexture(glyphTex, xpos + offsetX, ypos + offsetY, scale, color);
+        }
+
+        xpos += (int)((g.font->width * scale) + spacing);
+    }
+}
+
+// Малює текст стилем PSF_STYLE_*: текстури беруться з кешу стилізованої копії шрифту,
+// тому стилізований символ — одна текстура, як і звичайний
+void DrawPSFTextStyled(PSF_Font font, int x, int y, const char* text, int spacing, int style, float scale, Color color) {
+    const PSF_Font* styled = GetPSFStyledFont(&font, style);
+    if (!styled) return;
+    PSF_TextCursor cursor;
+    InitPSFTextCursor(&cursor, &font, text);
+    DrawPSFTextWithGlyphs(font, styled, GetPSFStylePadding(style), x, y, &cursor, spacing, scale, color);
+}
+
+// Текст з обведенням і/або тінню: спершу оздоблення кольором decorationColor, потім сам текст
+void DrawPSFTextDecorated(PSF_Font font, int x, int y, const char* text, int spacing, int style, float scale,
+                          Color textColor, Color decorationColor) {
+    if (style & (PSF_STYLE_OUTLINE | PSF_STYLE_SHADOW)) {
+        DrawPSFTextStyled(font, x, y, text, spacing, style, scale, decorationColor);
+    }
+    DrawPSFTextStyled(font, x, y, text, spacing, style & (PSF_STYLE_BOLD | PSF_STYLE_ITALIC), scale, textColor);
+}
+
+// Малює UTF-8 текст, повернутий на rotation = 90/180/270 градусів проти годинникової стрілки
+// навколо (x, y) — лівого верхнього кута тексту до повороту. Текстури беруться з кешу повернутої
+// копії шрифту (GetPSFRotatedFont), тож кожен гліф — та сама одна текстура, що й у DrawPSFText.
+void DrawPSFTextRotated(PSF_Font font, int x, int y, const char* text, int spacing, int rotation, float scale, Color color) {
+    const PSF_Font* rotated = GetPSFRotatedFont(&font, rotation);
+    if (!rotated) return;
+    GlyphCache* cache = GetCacheForFont(*rotated);
+    if (!cache) return;
+
+    rotation = ((rotation % 360) + 360) % 360;
+    int cellWidth = (int)(font.width * scale);
+    int cellHeight = (int)(font.height * scale);
+    int u = 0, v = 0;  // Позиція комірки символу в тексті до повороту
+
+    PSF_TextCursor cursor;
+    InitPSFTextCursor(&cursor, &font, text);
+    int glyph_index;
+    while ((glyph_index = NextPSFTextItem(&cursor)) != PSF_TEXT_END) {
+        if (glyph_index == PSF_TEXT_NEWLINE) {
+            u = 0;
+            v += cellHeight + spacing;
+            continue;
+        }
+
+        if (glyph_index < 0 || glyph_index >= font.charcount) glyph_index = 32;
+
+        // Лівий верхній кут повернутої комірки
+        int gx, gy;
+        switch (rotation) {
+            case 90:  gx = x + v;              gy = y - u - cellWidth;  break;
+            case 180: gx = x - u - cellWidth;  gy = y - v - cellHeight; break;
+            case 270: gx = x - v - cellHeight; gy = y + u;              break;
+            default:  gx = x + u;              gy = y + v;              break;
+        }
+
+        const PSF_GlyphBounds* bounds = GetPSFGlyphBounds(rotated, glyph_index);
+        if (!bounds || !bounds->isEmpty) {
+            Texture2D glyphTex = GlyphCache_GetTexture(cache, *rotated, glyph_index, scale);
+            int offsetX = bounds ? (int)(bounds->firstCol * scale) : 0;
+            int offsetY = bounds ? (int)(bounds->firstRow * scale) : 0;
+            DrawPSFCharScaledTexture(glyphTex, gx + offsetX, gy + offsetY, scale, color);
+        }
 
-        // Переходимо до наступного символу у тексті
-        text += bytes;
+        u += cellWidth + spacing;
     }
 }
 
@@ -5,6 +5,7 @@
 #include "raylib.h"
 #include <stdint.h>
 #include "psf_font.h"  // Структура PSF_Font
+#include "FontFallback.h"
 
 // Структура кешу текстур гліфів
 typedef struct {
@@ -28,9 +29,38 @@ void DrawPSFCharScaledTexture(Texture2D tex, int x, int y, float scale, Color co
 // який підтримує одночасну роботу з багатьма шрифтами
 void DrawPSFText(PSF_Font font, int x, int y, const char* text, int spacing, float scale, Color color);
 
+// Текст без завершального нуля і без повторного декодування: length байтів UTF-8, масив кодових
+// точок UTF-32 (напр. кільцевий буфер журналу) або масив індексів гліфів (PSF_TEXT_NEWLINE — перенос)
+void DrawPSFTextN(PSF_Font font, int x, int y, const char* text, size_t length, int spacing, float scale, Color color);
+void DrawPSFTextUTF32(PSF_Font font, int x, int y, const uint32_t* codepoints, size_t count, int spacing, float scale, Color color);
+void DrawPSFGlyphs(PSF_Font font, int x, int y, const int32_t* glyphs, size_t count, int spacing, float scale, Color color);
+
+// Малювання тексту, підготовленого PreparePSFText (лише вивід текстур за готовими позиціями)
+void DrawPreparedPSFText(const PSF_PreparedText* text, int x, int y, Color color);
+
+// Малювання тексту ланцюжком запасних шрифтів: символ, якого немає в основному шрифті,
+// береться з наступного шрифту ланцюжка (пошук кешується для кожної кодової точки)
+void DrawPSFTextFallback(FontFallback* fallback, int x, int y, const char* text, int spacing, float scale, Color color);
+
+// Малювання тексту стилем PSF_STYLE_* (одна текстура на символ)
+void DrawPSFTextStyled(PSF_Font font, int x, int y, const char* text, int spacing, int style, float scale, Color color);
+
+// Текст з обведенням/тінню (OUTLINE/SHADOW зі style) кольором decorationColor під текстом кольору textColor
+void DrawPSFTextDecorated(PSF_Font font, int x, int y, const char* text, int spacing, int style, float scale,
+                          Color textColor, Color decorationColor);
+
+// Малювання тексту, повернутого на 90/180/270 градусів проти годинникової стрілки навколо (x, y)
+void DrawPSFTextRotated(PSF_Font font, int x, int y, const char* text, int spacing, int rotation, float scale, Color color);
+
 // Звільнення всіх кешів, створених для різних шрифтів
 void GlyphCache_ClearAllCaches(void);
 
+// Звільнення кешу одного шрифту (викликається автоматично з UnloadPSFFont)
+void GlyphCache_ForgetFont(const PSF_Font* font);
+
+// Скидання текстури гліфа, зміненого при перезавантаженні шрифту (викликається автоматично)
+void GlyphCache_GlyphChanged(const PSF_Font* font, int glyphIndex);
+
 
 #endif // GLYPH_CACHE_H
 
@@ -0,0 +1,129 @@
+// GlyphPager.c
+#include "GlyphPager.h"
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>         // Для pread/close
+
+struct GlyphPager {
+    int fd;                        // Відкритий файл шрифту
+    off_t glyphOffset;             // Початок гліфів у файлі
+    int charcount;
+    int charsize;
+    int glyphsPerPage;
+    int pageCount;
+    unsigned char** pages;         // Таблиця сторінок: NULL — сторінка не завантажена
+    unsigned long* lastUse;        // Час останнього звернення до сторінки (для LRU)
+    unsigned long clock;           // Лічильник звернень
+    int residentPages;
+    int maxResidentPages;
+    unsigned long faults;
+    unsigned long evictions;
+};
+
+GlyphPager* GlyphPager_Create(int fd, off_t glyphOffset, int charcount, int charsize, int maxResidentPages) {
+    if (fd < 0 || charcount <= 0 || charsize <= 0) return NULL;
+
+    GlyphPager* pager = calloc(1, sizeof(GlyphPager));
+    if (!pager) return NULL;
+
+    pager->fd = fd;
+    pager->glyphOffset = glyphOffset;
+    pager->charcount = charcount;
+    pager->charsize = charsize;
+    pager->glyphsPerPage = GLYPH_PAGER_PAGE_BYTES / charsize;
+    if (pager->glyphsPerPage < 1) pager->glyphsPerPage = 1;
+    pager->pageCount = (charcount + pager->glyphsPerPage - 1) / pager->glyphsPerPage;
+    pager->maxResidentPages = maxResidentPages > 0 ? maxResidentPages : 0;
+
+    pager->pages = calloc(pager->pageCount, sizeof(unsigned char*));
+    pager->lastUse = calloc(pager->pageCount, sizeof(unsigned long));
+    if (!pager->pages || !pager->lastUse) {
+        free(pager->pages);
+        free(pager->lastUse);
+        free(pager);
+        return NULL;
+    }
+    return pager;
+}
+
+// Знаходить найдавніше використану сторінку і забирає її буфер
+static unsigned char* GlyphPager_EvictOldest(GlyphPager* pager) {
+    int victim = -1;
+    for (int i = 0; i < pager->pageCount; i++) {
+        if (pager->pages[i] && (victim < 0 || pager->lastUse[i] < pager->lastUse[victim])) {
+            victim = i;
+        }
+    }
+    if (victim < 0) return NULL;
+
+    unsigned char* buffer = pager->pages[victim];
+    pager->pages[victim] = NULL;
+    pager->residentPages--;
+    pager->evictions++;
+    return buffer;
+}
+
+// Читає сторінку з файлу (повторно використовуючи буфер витісненої сторінки, якщо є обмеження)
+static unsigned char* GlyphPager_LoadPage(GlyphPager* pager, int page) {
+    size_t pageBytes = (size_t)pager->glyphsPerPage * pager->charsize;
+    int first = page * pager->glyphsPerPage;
+    int count = pager->charcount - first;
+    if (count > pager->glyphsPerPage) count = pager->glyphsPerPage;
+    size_t bytes = (size_t)count * pager->charsize;
+
+    unsigned char* buffer = NULL;
+    if (pager->maxResidentPages && pager->residentPages >= pager->maxResidentPages) {
+        buffer = GlyphPager_EvictOldest(pager);
+    }
+    if (!buffer) buffer = malloc(pageBytes);
+    if (!buffer) return NULL;
+
+    off_t offset = pager->glyphOffset + (off_t)first * pager->charsize;
+    if (pread(pager->fd, buffer, bytes, offset) != (ssize_t)bytes) {
+        free(buffer);
+        return NULL;
+    }
+
+    pager->pages[page] = buffer;
+    pager->residentPages++;
+    pager->faults++;
+    return buffer;
+}
+
+const unsigned char* GlyphPager_GetGlyph(GlyphPager* pager, int index) {
+    if (!pager || index < 0 || index >= pager->charcount) return NULL;
+
+    int page = index / pager->glyphsPerPage;
+    unsigned char* data = pager->pages[page];
+    if (!data) {
+        data = GlyphPager_LoadPage(pager, page);
+        if (!data) return NULL;
+    }
+    pager->lastUse[page] = ++pager->clock;
+    return data + (size_t)(index % pager->glyphsPerPage) * pager->charsize;
+}
+
+void GlyphPager_GetStats(const GlyphPager* pager, GlyphPagerStats* stats) {
+    if (!stats) return;
+    memset(stats, 0, sizeof(*stats));
+    if (!pager) return;
+
+    stats->pageCount = pager->pageCount;
+    stats->glyphsPerPage = pager->glyphsPerPage;
+    stats->residentPages = pager->residentPages;
+    stats->maxResidentPages = pager->maxResidentPages;
+    stats->faults = pager->faults;
+    stats->evictions = pager->evictions;
+}
+
+void GlyphPager_Free(GlyphPager* pager) {
+    if (!pager) return;
+
+    for (int i = 0; i < pager->pageCount; i++) {
+        free(pager->pages[i]);
+    }
+    free(pager->pages);
+    free(pager->lastUse);
+    close(pager->fd);
+    free(pager);
+}
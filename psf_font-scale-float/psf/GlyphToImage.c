@@ -1,16 +1,43 @@
 // GlyphToImage.c
 #include "GlyphToImage.h"
 
-// Створює Image з гліфа PSF з заданим кольором
+// Створює Image з гліфа PSF з заданим кольором.
+// Якщо межі «чорнила» обчислено, зображення охоплює лише їх (без порожніх рядків і стовпців),
+// а зсув відносно комірки символу — (bounds->firstCol, bounds->firstRow).
 Image GlyphToImage(PSF_Font font, int glyphIndex, Color color) {
     int width = font.width;
     int height = font.height;
     int bytes_per_row = (width + 7) / 8;
-    unsigned char* glyph = font.glyphBuffer + glyphIndex * font.charsize;
 
-    Image img = GenImageColor(width, height, BLANK);
+    int left = 0, top = 0, right = width - 1, bottom = height - 1;
+    const PSF_GlyphBounds* bounds = GetPSFGlyphBounds(&font, glyphIndex);
+    if (bounds && !bounds->isEmpty) {
+        left = bounds->firstCol;
+        top = bounds->firstRow;
+        right = bounds->lastCol;
+        bottom = bounds->lastRow;
+    }
+
+    Image img = GenImageColor(right - left + 1, bottom - top + 1, BLANK);
+
+    const uint64_t* rows = GetPSFGlyphRows(&font, glyphIndex);
+    if (rows) {
+        // Швидкий шлях через рядкові маски: лише встановлені пікселі
+        for (int y = top; y <= bottom; y++) {
+            uint64_t bits = rows[y];
+            while (bits) {
+                int x = __builtin_clzll(bits);
+                bits &= ~(0x8000000000000000ULL >> x);
+                ImageDrawPixel(&img, x - left, y - top, WHITE);
+            }
+        }
+        return img;
+    }
+
+    const unsigned char* glyph = GetPSFGlyph(&font, glyphIndex);
+    if (!glyph) return img; // Порожнє зображення, якщо гліф недоступний
 
-    for (int y = 0; y < height; y++) {
+    for (int y = top; y <= bottom; y++) {
         for (int byte = 0; byte < bytes_per_row; byte++) {
             unsigned char bits = glyph[y * bytes_per_row + byte];
             for (int bit = 0; bit < 8; bit++) {
@@ -18,7 +45,7 @@ Image GlyphToImage(PSF_Font font, int glyphIndex, Color color) {
                 if (x >= width) break;
                 if (bits & (0x80 >> bit)) {
                     // Малюємо білим кольором (255,255,255,255) - альфа маска
-                    ImageDrawPixel(&img, x, y, WHITE);
+                    ImageDrawPixel(&img, x - left, y - top, WHITE);
                 }
             }
         }
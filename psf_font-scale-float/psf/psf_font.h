@@ -4,6 +4,41 @@
 
 #include "raylib.h"
 #include <stdint.h>
+#include <stddef.h>
+#include "UnicodeTable.h"
+#include "GlyphPager.h"
+#include "GlyphCompressor.h"
+
+// Звідки взято пам’ять гліфів (визначає, як її звільняти)
+typedef enum {
+    PSF_STORAGE_HEAP = 0,   // malloc + fread (LoadPSFFont)
+    PSF_STORAGE_MMAP,       // відображення файлу (LoadPSFFontMapped)
+    PSF_STORAGE_MEMORY,     // зовнішній буфер (LoadPSFFontFromMemory), не звільняється
+    PSF_STORAGE_PAGED,      // сторінки гліфів читаються на вимогу (LoadPSFFontPaged)
+    PSF_STORAGE_COMPRESSED  // гліфи стиснуті в пам’яті й розпаковуються на вимогу (CompressPSFFont)
+} PSF_Storage;
+
+// Межі «чорнила» гліфа, обчислені при завантаженні
+typedef struct {
+    uint16_t firstRow, lastRow;  // Перший і останній рядки з хоча б одним пікселем
+    uint16_t firstCol, lastCol;  // Перший і останній стовпці з хоча б одним пікселем
+    uint8_t isEmpty;             // 1 — гліф без жодного пікселя (пробіл), решта полів нульові
+} PSF_GlyphBounds;
+
+// Прямокутник з розкладу гліфа (координати в пікселях відносно комірки символу)
+typedef struct {
+    uint16_t x, y;               // Лівий верхній кут
+    uint16_t w, h;               // Ширина і висота
+} PSF_GlyphRect;
+
+// Синтетичні стилі шрифту (можна поєднувати), див. GetPSFStyledFont
+typedef enum {
+    PSF_STYLE_REGULAR = 0,
+    PSF_STYLE_BOLD    = 1 << 0,  // Жирний: кожен рядок OR з собою, зсунутим на 1 піксель
+    PSF_STYLE_ITALIC  = 1 << 1,  // Курсив: зсув рядків пропорційно висоті
+    PSF_STYLE_OUTLINE = 1 << 2,  // Лише обведення товщиною 1 піксель навколо гліфа
+    PSF_STYLE_SHADOW  = 1 << 3   // Лише тінь, зсунута на 1 піксель вправо-вниз
+} PSF_Style;
 
 // Структура шрифту PSF1/PSF2
 typedef struct {
@@ -13,13 +48,163 @@ typedef struct {
     int charcount;          // Кількість символів
     int charsize;           // Розмір гліфа в байтах
     unsigned char* glyphBuffer; // Дані гліфів
+    PSF_Storage storage;    // Походження пам’яті гліфів
+    void* mapBase;          // Початок mmap-відображення (NULL, якщо гліфи в купі)
+    size_t mapSize;         // Розмір відображення в байтах
+    UnicodeTable* unicodeTable; // Unicode-таблиця з файлу шрифту (NULL, якщо її немає)
+    GlyphPager* pager;      // Таблиця сторінок гліфів (лише для PSF_STORAGE_PAGED, тоді glyphBuffer == NULL)
+    GlyphCompressor* compressor; // Стиснуті гліфи (лише для PSF_STORAGE_COMPRESSED, тоді glyphBuffer == NULL)
+    uint64_t* rowMasks;     // Гліфи як рядкові маски uint64_t (NULL, якщо не побудовано BuildPSFRowMasks)
+    int rowStride;          // Кількість масок на гліф (кратна 8, тобто 64 байти)
+    PSF_GlyphBounds* glyphBounds; // Межі «чорнила» кожного гліфа (NULL для посторінкового шрифту)
+    PSF_GlyphRect* glyphRects;    // Розклад усіх гліфів на прямокутники (NULL, якщо не побудовано)
+    uint32_t* glyphRectStart;     // Початок прямокутників гліфа c у glyphRects (charcount + 1 елементів)
+    uint32_t serial;        // Унікальний номер завантаження (не повторюється) — ключ для залежних кешів
 } PSF_Font;
 
+// Символів, що декодуються за один прохід курсора тексту (PSF_TextCursor)
+#define PSF_TEXT_CHUNK 128
+
+// Особливі значення в масиві DecodePSFText і з NextPSFTextItem
+#define PSF_TEXT_NEWLINE (-1)   // Перенос рядка '\n'
+#define PSF_TEXT_END     (-2)   // Текст закінчився (лише NextPSFTextItem)
+
+// Курсор тексту для циклів малювання: UTF-8 декодується і перетворюється в індекси гліфів
+// порціями по PSF_TEXT_CHUNK символів (DecodePSFText), а не по символу за виклик.
+// Вхід UTF-32 лише перетворюється в індекси, готові індекси гліфів видаються як є.
+typedef struct {
+    const PSF_Font* font;           // Шрифт для індексів гліфів (NULL — курсор видає кодові точки)
+    const char* text;               // Ще не декодований залишок тексту
+    const uint32_t* codepoints;     // Або залишок кодових точок UTF-32
+    const int32_t* glyphs;          // Або залишок готових індексів гліфів
+    size_t remaining;               // Його довжина в байтах (в елементах для UTF-32 і гліфів)
+    int32_t items[PSF_TEXT_CHUNK];  // Декодована порція
+    int count;                      // Елементів у порції
+    int pos;                        // Наступний елемент порції
+} PSF_TextCursor;
+
+// Гліф підготовленого тексту (PreparePSFText)
+typedef struct {
+    int32_t glyph;           // Індекс гліфа у шрифті
+    int32_t x, y;            // Зсув «чорнила» гліфа від початку тексту (з масштабом)
+} PSF_PreparedGlyph;
+
+// Підготовлений текст: UTF-8 декодовано, гліфи знайдено і розкладено один раз,
+// тож малювання щокадру (DrawPreparedPSFText) лише виводить гліфи за готовими позиціями.
+// Незмінний після PreparePSFText; шрифт має жити довше за текст.
+typedef struct {
+    const PSF_Font* font;        // Шрифт, для якого розкладено текст
+    float scale;                 // Масштаб гліфів
+    PSF_PreparedGlyph* glyphs;   // Непорожні гліфи (пробіли не зберігаються)
+    int glyphCount;
+    int* lineStart;              // Перший гліф кожного рядка в glyphs (lineCount + 1 елементів)
+    int lineCount;               // Кількість рядків (переноси '\n' + 1)
+    int width, height;           // Габарит тексту в пікселях (найдовший рядок × усі рядки)
+} PSF_PreparedText;
+
+// Кеш розкладених рядків: записів (витісняється найдавніше використаний) і найдовший рядок у байтах
+#define PSF_TEXT_RUN_CACHE_SIZE 128
+#define PSF_TEXT_RUN_MAX_BYTES 256
+
+// Статистика кешу розкладених рядків (GetPSFTextRunCacheStats)
+typedef struct {
+    unsigned long hits;          // Малювань з готової розкладки
+    unsigned long misses;        // Рядків, розкладених і доданих до кешу
+    unsigned long evictions;     // Записів, витіснених новими рядками
+    unsigned long bypassed;      // Малювань без кешу (довгий рядок, шрифт без serial)
+    int entries;                 // Записів у кеші зараз
+    int capacity;                // PSF_TEXT_RUN_CACHE_SIZE
+} PSF_TextRunCacheStats;
+
+// Обробник звільнення шрифту: викликається з UnloadPSFFont до звільнення даних
+typedef void (*PSF_UnloadHook)(const PSF_Font* font);
+
+// Обробник зміни гліфа glyphIndex після ReloadPSFFontInPlace (font — уже нова версія)
+typedef void (*PSF_GlyphChangedHook)(const PSF_Font* font, int glyphIndex);
+
 int utf8_decode(const char* str, uint32_t* out_codepoint);
 int UnicodeToGlyphIndex(uint32_t codepoint);
+// Пошук гліфа через Unicode-таблицю шрифту (або ASCII + cyr_map, якщо таблиці немає)
+int FontUnicodeToGlyphIndex(const PSF_Font* font, uint32_t codepoint);
+// Індекс гліфа для кодової точки або -1, якщо шрифт його не має (без заміни пробілом)
+int FindPSFGlyph(const PSF_Font* font, uint32_t codepoint);
+// Пакетне UTF-8 → індекси гліфів (font == NULL — кодові точки), '\n' — PSF_TEXT_NEWLINE, некоректне — U+FFFD
+size_t DecodePSFText(const PSF_Font* font, const char* text, size_t length, int32_t* out, size_t capacity, size_t* consumed);
+// Курсор для циклів малювання: while ((glyph = NextPSFTextItem(&cursor)) != PSF_TEXT_END) { ... }
+void InitPSFTextCursor(PSF_TextCursor* cursor, const PSF_Font* font, const char* text);
+// Курсор по length байтах без нуля, по кодових точках UTF-32 і по готових індексах гліфів (PSF_TEXT_NEWLINE — перенос)
+void InitPSFTextCursorN(PSF_TextCursor* cursor, const PSF_Font* font, const char* text, size_t length);
+void InitPSFTextCursorUTF32(PSF_TextCursor* cursor, const PSF_Font* font, const uint32_t* codepoints, size_t count);
+void InitPSFTextCursorGlyphs(PSF_TextCursor* cursor, const int32_t* glyphs, size_t count);
+int NextPSFTextItem(PSF_TextCursor* cursor);
+int utf8_strlen(const char* s);
+// Підготовлений текст: декодування і розкладка один раз (малювання — DrawPreparedPSFText у GlyphCache.h)
+PSF_PreparedText* PreparePSFText(const PSF_Font* font, const char* text, int spacing, float scale);
+void FreePreparedPSFText(PSF_PreparedText* text);
+// Кеш розкладок для DrawPSFText: рядок з кешу або доданий до нього (NULL — не кешується); дійсна до наступного малювання.
+// Поле font розкладки з кешу — NULL: гліфи малюються шрифтом, переданим у GetPSFTextRun
+const PSF_PreparedText* GetPSFTextRun(const PSF_Font* font, const char* text, int spacing, float scale);
+void GetPSFTextRunCacheStats(PSF_TextRunCacheStats* stats);
+void ClearPSFTextRunCache(void);
 
+// Завантаження з файлу; стиснуті .psf.gz розпаковуються потоково (zlib)
 PSF_Font LoadPSFFont(const char* filename);
+
+// Те саме без завершення програми: повертає 1 при успіху, 0 при помилці
+// (для фонового завантаження, див. AsyncFontLoader.h)
+int TryLoadPSFFont(const char* filename, PSF_Font* out);
+// Запис шрифту у PSF2 з Unicode-таблицею активної відповідності (для перетворення PSF1 і підмножин); 1 — успіх
+int SavePSFFont(const PSF_Font* font, const char* filename);
+// Завантаження через mmap без копіювання гліфів (сторінки спільні між процесами; .psf.gz — як LoadPSFFont)
+PSF_Font LoadPSFFontMapped(const char* filename);
+// Посторінкове завантаження гліфів на вимогу (для великих шрифтів); maxResidentPages <= 0 — без обмеження,
+// статистика — GlyphPager_GetStats(font.pager, &stats)
+PSF_Font LoadPSFFontPaged(const char* filename, int maxResidentPages);
+// Дані гліфа з індексом index для будь-якого способу завантаження (NULL — індекс поза межами)
+const unsigned char* GetPSFGlyph(const PSF_Font* font, int index);
+// Перекодування гліфів у вирівняні 64-бітові маски рядків (ширина до 64, не для посторінкових шрифтів)
+int BuildPSFRowMasks(PSF_Font* font);
+// Маски рядків гліфа (старший біт — лівий піксель) або NULL, якщо їх не побудовано
+const uint64_t* GetPSFGlyphRows(const PSF_Font* font, int index);
+// Межі «чорнила» гліфа (порожні рядки/стовпці відкинуто) або NULL, якщо їх не обчислено
+const PSF_GlyphBounds* GetPSFGlyphBounds(const PSF_Font* font, int index);
+// Розклад гліфів на прямокутники (ширина до 64, не для посторінкових і стиснутих шрифтів);
+// DrawPSFChar/DrawPSFCharScaled тоді малюють гліф заливками прямокутників замість пікселів
+int BuildPSFGlyphRects(PSF_Font* font);
+// Розклад гліфа на прямокутники (*count штук) або NULL, якщо його не побудовано
+const PSF_GlyphRect* GetPSFGlyphRects(const PSF_Font* font, int index, int* count);
+// Завантаження з буфера в пам’яті без копіювання гліфів (буфер має жити довше за шрифт);
+// виділяються лише Unicode-індекс і межі «чорнила»
+PSF_Font LoadPSFFontFromMemory(const void* data, size_t size);
+
+// Те саме без завершення програми: повертає 1 при успіху, 0 при помилці
+int TryLoadPSFFontFromMemory(const void* data, size_t size, PSF_Font* out);
 void UnloadPSFFont(PSF_Font font);
+// Реєстрація обробника звільнення (до 8 штук), повертає 0, якщо місця немає
+int AddPSFUnloadHook(PSF_UnloadHook hook);
+// Реєстрація обробника зміни гліфів при перезавантаженні (до 8 штук)
+int AddPSFGlyphChangedHook(PSF_GlyphChangedHook hook);
+// Заміна даних шрифту на місці новою версією (newFont переходить у власність font), serial зберігається;
+// повертає кількість змінених гліфів
+int ReloadPSFFontInPlace(PSF_Font* font, PSF_Font newFont);
+// Залишає лише гліфи, досяжні з Unicode-відповідності (або кодових точок keep), щільно і найчастіші першими
+int CompactPSFFont(PSF_Font* font, const uint32_t* keep, int keepCount);
+// LoadPSFFont + CompactPSFFont для символів інтерфейсу (ASCII і cyr_map)
+PSF_Font LoadPSFFontCompact(const char* filename);
+// Кількість кодових точок з гліфом; *pages — сторінки U+p00..U+pFF (p < 64), де є хоч один гліф
+int GetPSFUnicodeCoverage(const PSF_Font* font, uint64_t* pages);
+// Стиснення гліфів у пам’яті (словник рядків + серії повторів) з кешем cacheSlots розпакованих гліфів
+// (<= 0 — типовий); 0 — стиснення не зменшує розмір, шрифт без змін. Статистика — GlyphCompressor_GetStats
+int CompressPSFFont(PSF_Font* font, int cacheSlots);
+PSF_Font LoadPSFFontCompressed(const char* filename, int cacheSlots);
+// Копія шрифту, повернута на 90/180/270 градусів проти годинникової стрілки (будується при першому
+// зверненні, звільняється з шрифтом); rotation = 0 — сам font, NULL — кут не кратний 90
+const PSF_Font* GetPSFRotatedFont(const PSF_Font* font, int rotation);
+// Стилізована копія шрифту (комбінація PSF_STYLE_*), будується один раз на шрифт і стиль;
+// з OUTLINE/SHADOW містить лише оздоблення. NULL — гліф стилю ширший за 64 пікселі
+const PSF_Font* GetPSFStyledFont(const PSF_Font* font, int style);
+// Зсув гліфа стилю вліво-вгору відносно комірки вихідного шрифту в пікселях
+int GetPSFStylePadding(int style);
 
 /*
 // Функція малювання тексту UTF-8 шрифтом PSF з підтримкою переносу рядків '\n'
@@ -106,6 +106,12 @@ void gfx_line( int x1, int y1, int x2, int y2 )
   XDrawLine(gfx_display,gfx_window,gfx_gc,x1,y1,x2,y2);
 }
 
+/* Fill a width x height rectangle at (x,y) with the current color in one request */
+void gfx_fill_rect( int x, int y, int width, int height )
+{
+  XFillRectangle(gfx_display,gfx_window,gfx_gc,x,y,width,height);
+}
+
 /* Change the current drawing color. */
 
 void gfx_color( int r, int g, int b )
@@ -15,11 +15,16 @@ int main(void) {
     Display_Set_HEIGHT(screenHeight);
     gfx_color(128,127,255);
 
-    // Завантаження PSF шрифту (шлях до вашого файлу)
-    psfFont12 = LoadPSFFont("fonts/Uni3-Terminus12x6.psf");
-    psfFont20 = LoadPSFFont("fonts/Uni3-Terminus20x10.psf");
-    psfFont28 = LoadPSFFont("fonts/Uni3-Terminus28x14.psf");
-    psfFont32 = LoadPSFFont("fonts/Uni3-Terminus32x16.psf");
+    // Завантаження PSF шрифту (шлях до вашого файлу; у збірці EMBED_FONTS=1 — з пам’яті програми)
+    psfFont12 = LoadPSFFontEmbedded("fonts/Uni3-Terminus12x6.psf");
+    psfFont20 = LoadPSFFontEmbedded("fonts/Uni3-Terminus20x10.psf");
+    psfFont28 = LoadPSFFontEmbedded("fonts/Uni3-Terminus28x14.psf");
+    psfFont32 = LoadPSFFontEmbedded("fonts/Uni3-Terminus32x16.psf");
+    // Бекенд заливає прямокутники: гліф малюється кількома заливками замість пікселів
+    BuildPSFGlyphRects(&psfFont12);
+    BuildPSFGlyphRects(&psfFont20);
+    BuildPSFGlyphRects(&psfFont28);
+    BuildPSFGlyphRects(&psfFont32);
 
     int scale = 1; // масштаб 1x
     int spacing = 2; // простір між символами px
@@ -15,6 +15,7 @@
 #include "display.h"
 
 #include "psf_font.h"  // заголовок із парсером PSF
+#include "EmbeddedFonts.h" // вбудовані шрифти (make EMBED_FONTS=1)
 
 #endif // MAIN_H
 
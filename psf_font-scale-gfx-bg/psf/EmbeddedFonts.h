@@ -0,0 +1,17 @@
+// EmbeddedFonts.h
+#ifndef EMBEDDED_FONTS_H
+#define EMBEDDED_FONTS_H
+
+#include <stddef.h>
+#include "psf_font.h"
+
+// Пошук файлу шрифту, вбудованого у програму (збірка `make EMBED_FONTS=1`).
+// filename — той самий шлях, що й для LoadPSFFont, напр. "fonts/Uni3-Terminus12x6.psf".
+// Повертає 1 і заповнює data/size, якщо шрифт вбудовано, інакше 0.
+int FindEmbeddedPSF(const char* filename, const void** data, size_t* size);
+
+// Повертає вбудований шрифт (без файлового вводу-виводу і без копіювання гліфів),
+// а якщо такого немає — завантажує його з файлу через LoadPSFFont.
+PSF_Font LoadPSFFontEmbedded(const char* filename);
+
+#endif // EMBEDDED_FONTS_H
@@ -0,0 +1,123 @@
+// FontFallback.c
+#include "FontFallback.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Порожня комірка кешу: значення, що не є кодовою точкою Unicode
+#define FALLBACK_EMPTY 0xFFFFFFFFu
+
+// Найбільша кодова точка Unicode; решта значень шукається як U+FFFD
+#define FALLBACK_MAX_CODEPOINT 0x10FFFF
+
+// Комірка кешу: кодова точка і знайдена для неї пара (шрифт ланцюжка, гліф)
+typedef struct {
+    uint32_t codepoint;          // FALLBACK_EMPTY — порожня
+    int32_t glyph;
+    int32_t font;                // Номер шрифту в ланцюжку
+} FallbackCacheEntry;
+
+struct FontFallback {
+    const PSF_Font* fonts[FONT_FALLBACK_MAX_FONTS];
+    uint32_t serials[FONT_FALLBACK_MAX_FONTS]; // serial шрифтів на момент заповнення кешу
+    int fontCount;
+    // Кеш з прямим відображенням: комірка = codepoint & cacheMask
+    FallbackCacheEntry* cache;
+    uint32_t cacheMask;
+    unsigned long hits;
+    unsigned long misses;
+};
+
+FontFallback* FontFallback_Create(int cacheSlots) {
+    if (cacheSlots <= 0) cacheSlots = FONT_FALLBACK_DEFAULT_CACHE;
+    int slots = 1;
+    while (slots < cacheSlots && slots < (1 << 24)) slots <<= 1;
+
+    FontFallback* fallback = (FontFallback*)calloc(1, sizeof(FontFallback));
+    if (!fallback) return NULL;
+    fallback->cache = (FallbackCacheEntry*)malloc((size_t)slots * sizeof(FallbackCacheEntry));
+    if (!fallback->cache) {
+        free(fallback);
+        return NULL;
+    }
+    fallback->cacheMask = (uint32_t)slots - 1;
+    FontFallback_Clear(fallback);
+    return fallback;
+}
+
+void FontFallback_Destroy(FontFallback* fallback) {
+    if (!fallback) return;
+    free(fallback->cache);
+    free(fallback);
+}
+
+void FontFallback_Clear(FontFallback* fallback) {
+    for (uint32_t i = 0; i <= fallback->cacheMask; i++) {
+        fallback->cache[i].codepoint = FALLBACK_EMPTY;
+    }
+}
+
+int FontFallback_AddFont(FontFallback* fallback, const PSF_Font* font) {
+    if (!font || fallback->fontCount >= FONT_FALLBACK_MAX_FONTS) return 0;
+    fallback->fonts[fallback->fontCount] = font;
+    fallback->serials[fallback->fontCount] = font->serial;
+    fallback->fontCount++;
+    // Новий шрифт може мати гліфи для символів, які раніше замінювалися пробілом
+    FontFallback_Clear(fallback);
+    return 1;
+}
+
+const PSF_Font* FontFallback_GetPrimary(const FontFallback* fallback) {
+    return fallback->fontCount > 0 ? fallback->fonts[0] : NULL;
+}
+
+int FontFallback_Revalidate(FontFallback* fallback) {
+    int changed = 0;
+    for (int i = 0; i < fallback->fontCount; i++) {
+        if (fallback->serials[i] != fallback->fonts[i]->serial) {
+            fallback->serials[i] = fallback->fonts[i]->serial;
+            changed = 1;
+        }
+    }
+    if (changed) FontFallback_Clear(fallback);
+    return changed;
+}
+
+// Пошук через ланцюжок: перший шрифт, що має гліф; інакше пробіл основного шрифту
+static void ResolveThroughChain(const FontFallback* fallback, uint32_t codepoint, FallbackCacheEntry* entry) {
+    for (int i = 0; i < fallback->fontCount; i++) {
+        int glyph = FindPSFGlyph(fallback->fonts[i], codepoint);
+        if (glyph >= 0) {
+            entry->font = i;
+            entry->glyph = glyph;
+            return;
+        }
+    }
+    int space = FindPSFGlyph(fallback->fonts[0], ' ');
+    entry->font = 0;
+    entry->glyph = space >= 0 ? space : 32;
+}
+
+FontFallbackGlyph FontFallback_Resolve(FontFallback* fallback, uint32_t codepoint) {
+    FontFallbackGlyph result = { NULL, 32 };
+    if (fallback->fontCount == 0) return result;
+    if (codepoint > FALLBACK_MAX_CODEPOINT) codepoint = 0xFFFD;
+
+    FallbackCacheEntry* entry = &fallback->cache[codepoint & fallback->cacheMask];
+    if (entry->codepoint == codepoint) {
+        fallback->hits++;
+    } else {
+        fallback->misses++;
+        ResolveThroughChain(fallback, codepoint, entry);
+        entry->codepoint = codepoint;
+    }
+    result.font = fallback->fonts[entry->font];
+    result.glyph = entry->glyph;
+    return result;
+}
+
+void FontFallback_GetStats(const FontFallback* fallback, FontFallbackStats* stats) {
+    stats->fontCount = fallback->fontCount;
+    stats->cacheSlots = (int)fallback->cacheMask + 1;
+    stats->hits = fallback->hits;
+    stats->misses = fallback->misses;
+}
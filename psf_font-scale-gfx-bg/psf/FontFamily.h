@@ -0,0 +1,81 @@
+// FontFamily.h
+#ifndef FONT_FAMILY_H
+#define FONT_FAMILY_H
+
+#include <stdint.h>
+#include "psf_font.h"
+
+// Родина шрифтів: один рисунок у кількох нативних розмірах і насиченостях
+// (Uni3-Terminus 12x6 ... 32x16 і Uni3-TerminusBold 18x10 ... 32x16)
+typedef struct FontFamily FontFamily;
+
+// Насиченість шрифту родини
+typedef enum {
+    FONT_WEIGHT_REGULAR = 0,
+    FONT_WEIGHT_BOLD,
+    FONT_WEIGHT_COUNT
+} FontWeight;
+
+// Ім’я файлу індексу метаданих у каталозі шрифтів (див. FontFamily_LoadDirectory)
+#define FONT_FAMILY_INDEX_NAME ".psf-index"
+
+// Метадані шрифту родини (з індексу або заголовка файлу)
+typedef struct {
+    char name[64];           // Ім’я файлу, напр. "Uni3-TerminusBold18x10.psf" (порожнє для AddFace)
+    int width;               // Ширина гліфа в пікселях
+    int height;              // Висота гліфа в пікселях
+    int charcount;           // Кількість гліфів
+    FontWeight weight;
+    int64_t fileSize;        // Розмір і час зміни файлу — для перевірки актуальності індексу
+    int64_t mtime;
+    int mappedCount;         // Кількість кодових точок, для яких є гліф
+    uint64_t coveragePages;  // Біт p — є гліф хоча б для однієї точки U+p00..U+pFF (p < 64)
+} FontFaceInfo;
+
+// Результат вибору розміру
+typedef struct {
+    const PSF_Font* font;    // Нативний шрифт родини (NULL, якщо родина порожня)
+    int scale;               // Цілий залишковий масштаб (>= 1) для DrawPSFTextScaled
+    float fractionalScale;   // Дробовий залишковий масштаб targetHeight / font->height (текстури raylib)
+} FontSizeChoice;
+
+// Створює порожню родину з ім’ям name (може бути NULL)
+FontFamily* FontFamily_Create(const char* name);
+
+// Сканує каталог dir і збирає в родину всі файли name*.psf і nameBold*.psf
+// (напр. name = "Uni3-Terminus"; також .psfu і стиснуті .psf.gz, .psfu.gz). Метадані беруться з індексу dir/.psf-index, якщо розмір
+// і час зміни файлу збігаються. Новий чи змінений файл (зокрема шрифт іншої родини, бо індекс
+// спільний для каталогу) завантажується повністю, щоб обчислити покриття Unicode, а індекс
+// перезаписується; такий шрифт родини лишається завантаженим, чужий одразу звільняється.
+// Решта шрифтів родини завантажується при першому виборі розміру.
+// Повертає NULL, якщо каталог не вдалося прочитати або в ньому немає шрифтів родини.
+FontFamily* FontFamily_LoadDirectory(const char* dir, const char* name);
+
+// Звільняє родину і шрифти, які вона завантажила (додані через AddFace не звільняються)
+void FontFamily_Destroy(FontFamily* family);
+
+// Додає нативний розмір. Вказівник має бути дійсним весь час життя родини
+// (шрифт з FontRegistry_Get, FontPack_GetFace або власна змінна). Повертає 1 при успіху.
+int FontFamily_AddFace(FontFamily* family, const PSF_Font* font);
+int FontFamily_AddFaceWeight(FontFamily* family, const PSF_Font* font, FontWeight weight);
+
+// Ім’я родини
+const char* FontFamily_GetName(const FontFamily* family);
+
+// Кількість шрифтів і їхні метадані (порядок: насиченість, потім висота)
+int FontFamily_FaceCount(const FontFamily* family);
+const FontFaceInfo* FontFamily_GetFaceInfo(const FontFamily* family, int index);
+
+// Найкращий нативний розмір для висоти комірки targetHeight: замість збільшення дрібного шрифту
+// береться найбільший нативний, що вміщається, а решту добирає залишковий масштаб
+// (цілий — найбільший, за якого текст не перевищує targetHeight, або точний дробовий).
+// Якщо не вміщається жоден — найменший шрифт. Рішення кешується для кожної висоти,
+// тож виклик щокадру — це одне звернення до таблиці.
+FontSizeChoice FontFamily_Select(FontFamily* family, int targetHeight);
+
+// Те саме для заданої насиченості (якщо її в родині немає — звичайна).
+// Шрифт з каталогу завантажується при першому виборі і далі лишається в пам’яті,
+// тож перемикання розміру і насиченості не перечитує файли.
+FontSizeChoice FontFamily_SelectWeight(FontFamily* family, int targetHeight, FontWeight weight);
+
+#endif // FONT_FAMILY_H
@@ -0,0 +1,155 @@
+// FontPack.c
+#include "FontPack.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>          // Для open
+#include <unistd.h>         // Для close
+#include <sys/mman.h>       // Для mmap/munmap
+#include <sys/stat.h>       // Для fstat (розмір файлу)
+
+// Стан шрифту пакета
+typedef struct {
+    FontPackInfo info;
+    PSF_Font font;           // Дійсний, якщо loaded == 1
+    int loaded;              // 0 — ще не розбирався, 1 — готовий, -1 — пошкоджений
+} FontPackFace;
+
+struct FontPack {
+    const unsigned char* base;  // Відображення файлу пакета
+    size_t size;
+    int faceCount;
+    FontPackFace faces[];       // faceCount записів
+};
+
+// Читання 4 байтів у форматі little-endian
+static uint32_t FontPack_ReadLE32(const unsigned char* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// Розбір і перевірка одного запису індексу
+static int FontPack_ParseEntry(const unsigned char* e, size_t packSize, FontPackInfo* info) {
+    memcpy(info->name, e + FONT_PACK_ENTRY_NAME, FONT_PACK_NAME_LEN);
+    info->name[FONT_PACK_NAME_LEN - 1] = '\0';
+    info->width = (int)FontPack_ReadLE32(e + FONT_PACK_ENTRY_WIDTH);
+    info->height = (int)FontPack_ReadLE32(e + FONT_PACK_ENTRY_HEIGHT);
+    info->style = (int)FontPack_ReadLE32(e + FONT_PACK_ENTRY_STYLE);
+    info->charcount = (int)FontPack_ReadLE32(e + FONT_PACK_ENTRY_CHARCOUNT);
+    info->offset = FontPack_ReadLE32(e + FONT_PACK_ENTRY_OFFSET);
+    info->size = FontPack_ReadLE32(e + FONT_PACK_ENTRY_SIZE_BYTES);
+
+    return (size_t)info->offset <= packSize && (size_t)info->size <= packSize - info->offset;
+}
+
+FontPack* FontPack_Open(const char* filename) {
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        printf("Не вдалося відкрити пакет шрифтів: %s\n", filename);
+        return NULL;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < FONT_PACK_HEADER_SIZE) {
+        printf("Пакет шрифтів порожній або недоступний: %s\n", filename);
+        close(fd);
+        return NULL;
+    }
+
+    size_t size = (size_t)st.st_size;
+    void* base = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd); // Дескриптор більше не потрібен, відображення лишається дійсним
+    if (base == MAP_FAILED) {
+        printf("Не вдалося відобразити пакет шрифтів у пам’ять: %s\n", filename);
+        return NULL;
+    }
+
+    const unsigned char* p = (const unsigned char*)base;
+    uint32_t faceCount = FontPack_ReadLE32(p + 8);
+    if (memcmp(p, FONT_PACK_MAGIC, 4) != 0 ||
+        FontPack_ReadLE32(p + 4) != FONT_PACK_VERSION ||
+        FontPack_ReadLE32(p + 12) != FONT_PACK_ENTRY_SIZE ||
+        faceCount > (size - FONT_PACK_HEADER_SIZE) / FONT_PACK_ENTRY_SIZE) {
+        printf("Формат пакета шрифтів не підтримується або файл пошкоджено: %s\n", filename);
+        munmap(base, size);
+        return NULL;
+    }
+
+    FontPack* pack = calloc(1, sizeof(FontPack) + faceCount * sizeof(FontPackFace));
+    if (!pack) {
+        munmap(base, size);
+        return NULL;
+    }
+    pack->base = p;
+    pack->size = size;
+    pack->faceCount = (int)faceCount;
+
+    for (int i = 0; i < pack->faceCount; i++) {
+        const unsigned char* e = p + FONT_PACK_HEADER_SIZE + (size_t)i * FONT_PACK_ENTRY_SIZE;
+        if (!FontPack_ParseEntry(e, size, &pack->faces[i].info)) {
+            printf("Пошкоджений запис %d у пакеті шрифтів: %s\n", i, filename);
+            pack->faces[i].loaded = -1;
+        }
+    }
+    return pack;
+}
+
+void FontPack_Close(FontPack* pack) {
+    if (!pack) return;
+
+    for (int i = 0; i < pack->faceCount; i++) {
+        if (pack->faces[i].loaded == 1) {
+            // storage MEMORY: гліфи лишаються у відображенні, звільняються Unicode-індекс, межі «чорнила»
+            // і прямокутники чи маски, якщо їх будували
+            UnloadPSFFont(pack->faces[i].font);
+        }
+    }
+    munmap((void*)pack->base, pack->size);
+    free(pack);
+}
+
+int FontPack_FaceCount(const FontPack* pack) {
+    return pack ? pack->faceCount : 0;
+}
+
+const FontPackInfo* FontPack_GetInfo(const FontPack* pack, int index) {
+    if (!pack || index < 0 || index >= pack->faceCount) return NULL;
+    return &pack->faces[index].info;
+}
+
+int FontPack_FindByName(const FontPack* pack, const char* name) {
+    if (!pack || !name) return -1;
+
+    // Дозволяємо шлях до файлу: відкидаємо каталог і розширення .psf
+    const char* slash = strrchr(name, '/');
+    if (slash) name = slash + 1;
+    size_t len = strlen(name);
+    if (len > 4 && strcmp(name + len - 4, ".psf") == 0) len -= 4;
+
+    for (int i = 0; i < pack->faceCount; i++) {
+        const char* faceName = pack->faces[i].info.name;
+        if (strncmp(faceName, name, len) == 0 && faceName[len] == '\0') return i;
+    }
+    return -1;
+}
+
+int FontPack_FindBySize(const FontPack* pack, int height, int style) {
+    if (!pack) return -1;
+
+    for (int i = 0; i < pack->faceCount; i++) {
+        const FontPackInfo* info = &pack->faces[i].info;
+        if (pack->faces[i].loaded >= 0 && info->height == height && info->style == style) return i;
+    }
+    return -1;
+}
+
+const PSF_Font* FontPack_GetFace(FontPack* pack, int index) {
+    if (!pack || index < 0 || index >= pack->faceCount) return NULL;
+
+    FontPackFace* face = &pack->faces[index];
+    if (face->loaded == 0) {
+        // Перше звернення: розбір на місці, гліфи лишаються у відображенні пакета
+        face->loaded = TryLoadPSFFontFromMemory(pack->base + face->info.offset, face->info.size,
+                                                &face->font) ? 1 : -1;
+    }
+    return face->loaded == 1 ? &face->font : NULL;
+}
@@ -0,0 +1,26 @@
+// Utf8Decoder.h
+#ifndef UTF8_DECODER_H
+#define UTF8_DECODER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Символ-замінник для некоректних послідовностей UTF-8
+#define UTF8_REPLACEMENT 0xFFFD
+
+// Пакетне декодування UTF-8 у масив кодових точок з перевіркою коректності.
+// ASCII обробляється блоками по 16 байтів (SSE2) або 32 байти (AVX2, якщо процесор його має —
+// перевіряється під час виконання); на інших архітектурах — звичайний цикл.
+// Некоректна послідовність (зайвий байт продовження, надлишкове кодування, сурогат,
+// значення понад U+10FFFF, обірваний символ) замінюється одним U+FFFD на найдовшу коректну
+// частину послідовності, як вимагає стандарт Unicode. Байти поза length не читаються.
+
+// Декодує не більше capacity символів з length байтів text. Повертає кількість кодових точок
+// у out; у *consumed (може бути NULL) — кількість прочитаних байтів (менша за length,
+// лише якщо out заповнено).
+size_t Utf8Decoder_Decode(const char* text, size_t length, uint32_t* out, size_t capacity, size_t* consumed);
+
+// Кількість символів у length байтах text (некоректна послідовність рахується як один U+FFFD)
+size_t Utf8Decoder_Count(const char* text, size_t length);
+
+#endif // UTF8_DECODER_H
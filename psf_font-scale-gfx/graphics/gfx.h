@@ -26,6 +26,9 @@ void DrawPixel(uint16_t x, uint16_t y, uint32_t color);
 /* Draw a line from (x1,y1) to (x2,y2) */
 void gfx_line( int x1, int y1, int x2, int y2 );
 
+/* Fill a rectangle with the current color. */
+void gfx_fill_rect( int x, int y, int width, int height );
+
 /* Change the current drawing color. */
 void gfx_color( int red, int green, int blue );
 
@@ -15,11 +15,23 @@ int main(void) {
     Display_Set_HEIGHT(screenHeight);
     gfx_color(128,127,255);
 
-    // Завантаження PSF шрифту (шлях до вашого файлу)
-    psfFont12 = LoadPSFFont("fonts/Uni3-Terminus12x6.psf");
-    psfFont20 = LoadPSFFont("fonts/Uni3-Terminus20x10.psf");
-    psfFont28 = LoadPSFFont("fonts/Uni3-Terminus28x14.psf");
-    psfFont32 = LoadPSFFont("fonts/Uni3-Terminus32x16.psf");
+    // Завантаження PSF шрифту (шлях до вашого файлу; у збірці EMBED_FONTS=1 — з пам’яті програми)
+    psfFont12 = LoadPSFFontEmbedded("fonts/Uni3-Terminus12x6.psf");
+    psfFont20 = LoadPSFFontEmbedded("fonts/Uni3-Terminus20x10.psf");
+    psfFont28 = LoadPSFFontEmbedded("fonts/Uni3-Terminus28x14.psf");
+    psfFont32 = LoadPSFFontEmbedded("fonts/Uni3-Terminus32x16.psf");
+    // Бекенд заливає прямокутники: гліф малюється кількома заливками замість пікселів
+    BuildPSFGlyphRects(&psfFont12);
+    BuildPSFGlyphRects(&psfFont20);
+    BuildPSFGlyphRects(&psfFont28);
+    BuildPSFGlyphRects(&psfFont32);
+
+    // Родина нативних розмірів: замість збільшення 12x6 береться найбільший шрифт, що вміщається
+    FontFamily* terminus = FontFamily_Create("Uni3-Terminus");
+    FontFamily_AddFace(terminus, &psfFont12);
+    FontFamily_AddFace(terminus, &psfFont20);
+    FontFamily_AddFace(terminus, &psfFont28);
+    FontFamily_AddFace(terminus, &psfFont32);
 
     int scale = 1; // масштаб 1x
     int spacing = 2; // простір між символами px
@@ -28,12 +40,14 @@ int main(void) {
         DrawPSFTextScaled(psfFont32, 20, 10, "Текст UTF-8", spacing, scale, WHITE);
         DrawPSFText(psfFont32, 20, 50, "Текст UTF-8", spacing, GREEN);
         DrawPSFText(psfFont12, 20, 90, "Малий Текст UTF-8", 1, YELLOW);
-        DrawPSFTextScaled(psfFont12, 20, 110, "Масштабований Текст", spacing, scale*2, YELLOW);
+        FontSizeChoice label = FontFamily_Select(terminus, 28); // 28x14 без масштабу
+        DrawPSFTextScaled(*label.font, 20, 110, "Масштабований Текст", spacing, label.scale, YELLOW);
 
         usleep(10000);
     }
 
     // Після виходу з циклу звільняємо пам'ять шрифту
+    FontFamily_Destroy(terminus);
     UnloadPSFFont(psfFont12);
     UnloadPSFFont(psfFont20);
     UnloadPSFFont(psfFont28);
@@ -15,6 +15,8 @@
 #include "display.h"
 
 #include "psf_font.h"  // заголовок із парсером PSF
+#include "EmbeddedFonts.h" // вбудовані шрифти (make EMBED_FONTS=1)
+#include "FontFamily.h"   // вибір нативного розміру шрифту
 
 #endif // MAIN_H
 
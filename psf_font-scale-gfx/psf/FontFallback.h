@@ -0,0 +1,65 @@
+// FontFallback.h
+#ifndef FONT_FALLBACK_H
+#define FONT_FALLBACK_H
+
+#include <stdint.h>
+#include "psf_font.h"
+
+// Найбільша кількість шрифтів у ланцюжку
+#define FONT_FALLBACK_MAX_FONTS 8
+
+// Типова кількість комірок кешу: ASCII, латиниця, грецька, кирилиця і псевдографіка
+// (U+2500..U+25FF) потрапляють у різні комірки без колізій
+#define FONT_FALLBACK_DEFAULT_CACHE 4096
+
+// Ланцюжок запасних шрифтів: символ, якого немає в основному шрифті (напр. Terminus),
+// шукається в наступних (шрифт символів, великий багатомовний шрифт) за порядком додавання.
+// Результат — пара (шрифт, гліф) — обчислюється один раз на кодову точку і зберігається
+// в спільному кеші з прямою адресацією, тож символ будь-якої писемності коштує одне
+// звернення до таблиці.
+typedef struct FontFallback FontFallback;
+
+// Результат пошуку гліфа
+typedef struct {
+    const PSF_Font* font;    // Шрифт ланцюжка, з якого береться гліф (NULL, якщо ланцюжок порожній)
+    int glyph;               // Індекс гліфа у font
+} FontFallbackGlyph;
+
+// Статистика кешу
+typedef struct {
+    int fontCount;           // Шрифтів у ланцюжку
+    int cacheSlots;          // Комірок кешу
+    unsigned long hits;      // Пошуків, обслужених кешем
+    unsigned long misses;    // Пошуків через ланцюжок шрифтів
+} FontFallbackStats;
+
+// Створює порожній ланцюжок. cacheSlots <= 0 — FONT_FALLBACK_DEFAULT_CACHE
+// (округлюється вгору до степеня двійки). NULL — якщо бракує пам’яті.
+FontFallback* FontFallback_Create(int cacheSlots);
+
+// Звільняє ланцюжок і кеш (самі шрифти не звільняються)
+void FontFallback_Destroy(FontFallback* fallback);
+
+// Додає шрифт у кінець ланцюжка; перший доданий — основний (його висота задає висоту рядка,
+// його пробіл замінює символи, яких немає в жодному шрифті). Вказівник має бути дійсним
+// весь час життя ланцюжка. Повертає 0, якщо ланцюжок повний.
+int FontFallback_AddFont(FontFallback* fallback, const PSF_Font* font);
+
+// Основний шрифт ланцюжка або NULL
+const PSF_Font* FontFallback_GetPrimary(const FontFallback* fallback);
+
+// Шрифт і гліф для кодової точки: з кешу або першим шрифтом ланцюжка, що має гліф
+FontFallbackGlyph FontFallback_Resolve(FontFallback* fallback, uint32_t codepoint);
+
+// Скидає кеш, якщо шрифт ланцюжка замінено (CompactPSFFont дає новий serial).
+// Викликається функціями малювання на початку кожного рядка тексту. Повертає 1, якщо кеш скинуто.
+int FontFallback_Revalidate(FontFallback* fallback);
+
+// Повністю скидає кеш (напр. після ReloadPSFFontInPlace зі зміненою Unicode-таблицею,
+// коли serial шрифту лишається тим самим)
+void FontFallback_Clear(FontFallback* fallback);
+
+// Заповнює статистику
+void FontFallback_GetStats(const FontFallback* fallback, FontFallbackStats* stats);
+
+#endif // FONT_FALLBACK_H
@@ -0,0 +1,400 @@
+// FontFamily.c
+#include "FontFamily.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <inttypes.h>
+#include <dirent.h>
+#include <sys/stat.h>
+
+// Висоти, для яких рішення кешуються в прямій таблиці
+#define FONT_FAMILY_CACHED_HEIGHTS 256
+
+// Рішення, ще не обчислене для висоти
+#define FONT_FAMILY_NO_CHOICE (-1)
+
+// Перший рядок файлу індексу (версія формату)
+#define FONT_FAMILY_INDEX_HEADER "# psf-index 1"
+
+// Шрифт родини
+typedef struct {
+    FontFaceInfo info;
+    const PSF_Font* font;    // NULL — ще не завантажено з path
+    char* path;              // Файл шрифту (NULL для AddFace)
+    PSF_Font* owned;         // Шрифт, завантажений самою родиною (окреме виділення — адреса стабільна)
+    int loadFailed;          // Файл не вдалося завантажити — розмір пропускається
+} FontFace;
+
+struct FontFamily {
+    char* name;
+    FontFace* faces;         // У порядку насиченості, потім зростання висоти
+    int faceCount;
+    int faceCapacity;
+    // Кеш рішень: номер шрифту для кожної насиченості й висоти
+    int16_t cachedFace[FONT_WEIGHT_COUNT][FONT_FAMILY_CACHED_HEIGHTS];
+};
+
+// Скидає кеш рішень (після додавання розміру або невдалого завантаження)
+static void FontFamily_ResetCache(FontFamily* family) {
+    for (int w = 0; w < FONT_WEIGHT_COUNT; w++) {
+        for (int h = 0; h < FONT_FAMILY_CACHED_HEIGHTS; h++) {
+            family->cachedFace[w][h] = FONT_FAMILY_NO_CHOICE;
+        }
+    }
+}
+
+FontFamily* FontFamily_Create(const char* name) {
+    FontFamily* family = calloc(1, sizeof(FontFamily));
+    if (!family) return NULL;
+    if (name) {
+        size_t len = strlen(name) + 1;
+        family->name = malloc(len);
+        if (family->name) memcpy(family->name, name, len);
+    }
+    FontFamily_ResetCache(family);
+    return family;
+}
+
+// Звільняє шрифт, завантажений родиною
+static void FontFamily_FreeOwned(FontFace* face) {
+    if (!face->owned) return;
+    UnloadPSFFont(*face->owned);
+    free(face->owned);
+    face->owned = NULL;
+}
+
+void FontFamily_Destroy(FontFamily* family) {
+    if (!family) return;
+    for (int i = 0; i < family->faceCount; i++) {
+        FontFamily_FreeOwned(&family->faces[i]);
+        free(family->faces[i].path);
+    }
+    free(family->name);
+    free(family->faces);
+    free(family);
+}
+
+// Вставляє шрифт зі збереженням порядку (насиченість, висота); повертає його номер або -1
+static int FontFamily_Insert(FontFamily* family, const FontFace* face) {
+    if (family->faceCount == family->faceCapacity) {
+        int capacity = family->faceCapacity ? family->faceCapacity * 2 : 8;
+        FontFace* faces = realloc(family->faces, capacity * sizeof(FontFace));
+        if (!faces) return -1;
+        family->faces = faces;
+        family->faceCapacity = capacity;
+    }
+
+    int i = family->faceCount;
+    while (i > 0) {
+        const FontFaceInfo* prev = &family->faces[i - 1].info;
+        if (prev->weight < face->info.weight ||
+            (prev->weight == face->info.weight && prev->height <= face->info.height)) break;
+        family->faces[i] = family->faces[i - 1];
+        i--;
+    }
+    family->faces[i] = *face;
+    family->faceCount++;
+    FontFamily_ResetCache(family);
+    return i;
+}
+
+// Метадані з уже завантаженого шрифту
+static void FontFamily_FillInfo(FontFaceInfo* info, const PSF_Font* font) {
+    info->width = font->width;
+    info->height = font->height;
+    info->charcount = font->charcount;
+    info->mappedCount = GetPSFUnicodeCoverage(font, &info->coveragePages);
+}
+
+int FontFamily_AddFaceWeight(FontFamily* family, const PSF_Font* font, FontWeight weight) {
+    if (!family || !font || font->height <= 0) return 0;
+    if (weight < 0 || weight >= FONT_WEIGHT_COUNT) return 0;
+
+    FontFace face;
+    memset(&face, 0, sizeof(face));
+    FontFamily_FillInfo(&face.info, font);
+    face.info.weight = weight;
+    face.font = font;
+    return FontFamily_Insert(family, &face) >= 0;
+}
+
+int FontFamily_AddFace(FontFamily* family, const PSF_Font* font) {
+    return FontFamily_AddFaceWeight(family, font, FONT_WEIGHT_REGULAR);
+}
+
+const char* FontFamily_GetName(const FontFamily* family) {
+    return family ? family->name : NULL;
+}
+
+int FontFamily_FaceCount(const FontFamily* family) {
+    return family ? family->faceCount : 0;
+}
+
+const FontFaceInfo* FontFamily_GetFaceInfo(const FontFamily* family, int index) {
+    if (!family || index < 0 || index >= family->faceCount) return NULL;
+    return &family->faces[index].info;
+}
+
+// ---------------------------------------------------------------------------
+// Індекс метаданих каталогу
+// ---------------------------------------------------------------------------
+
+// Записи індексу: один рядок на файл шрифту каталогу
+typedef struct {
+    FontFaceInfo* entries;
+    int count;
+    int capacity;
+} FontIndex;
+
+static FontFaceInfo* FontIndex_Append(FontIndex* index) {
+    if (index->count == index->capacity) {
+        int capacity = index->capacity ? index->capacity * 2 : 16;
+        FontFaceInfo* entries = realloc(index->entries, capacity * sizeof(FontFaceInfo));
+        if (!entries) return NULL;
+        index->entries = entries;
+        index->capacity = capacity;
+    }
+    FontFaceInfo* info = &index->entries[index->count++];
+    memset(info, 0, sizeof(*info));
+    return info;
+}
+
+static const FontFaceInfo* FontIndex_Find(const FontIndex* index, const char* name) {
+    for (int i = 0; i < index->count; i++) {
+        if (strcmp(index->entries[i].name, name) == 0) return &index->entries[i];
+    }
+    return NULL;
+}
+
+// Читає індекс каталогу; відсутній чи іншої версії індекс — просто порожній
+static void FontIndex_Read(FontIndex* index, const char* path) {
+    FILE* f = fopen(path, "r");
+    if (!f) return;
+
+    char line[256];
+    if (!fgets(line, sizeof(line), f) || strncmp(line, FONT_FAMILY_INDEX_HEADER, strlen(FONT_FAMILY_INDEX_HEADER)) != 0) {
+        fclose(f);
+        return;
+    }
+    while (fgets(line, sizeof(line), f)) {
+        FontFaceInfo entry;
+        memset(&entry, 0, sizeof(entry));
+        int weight;
+        if (sscanf(line, "%63s %" SCNd64 " %" SCNd64 " %d %d %d %d %d %" SCNx64,
+                   entry.name, &entry.fileSize, &entry.mtime, &entry.width, &entry.height,
+                   &entry.charcount, &weight, &entry.mappedCount, &entry.coveragePages) != 9) continue;
+        if (weight < 0 || weight >= FONT_WEIGHT_COUNT || entry.height <= 0) continue;
+        entry.weight = (FontWeight)weight;
+        FontFaceInfo* info = FontIndex_Append(index);
+        if (info) *info = entry;
+    }
+    fclose(f);
+}
+
+// Перезаписує індекс через тимчасовий файл (інший процес ніколи не бачить половину файлу).
+// Каталог лише для читання — не помилка: наступний запуск просто знову розбере заголовки.
+static void FontIndex_Write(const FontIndex* index, const char* path) {
+    char tmpPath[4096];
+    if (snprintf(tmpPath, sizeof(tmpPath), "%s.tmp", path) >= (int)sizeof(tmpPath)) return;
+    FILE* f = fopen(tmpPath, "w");
+    if (!f) return;
+
+    fprintf(f, "%s\n", FONT_FAMILY_INDEX_HEADER);
+    fprintf(f, "# name size mtime width height charcount weight mapped coverage\n");
+    for (int i = 0; i < index->count; i++) {
+        const FontFaceInfo* e = &index->entries[i];
+        fprintf(f, "%s %" PRId64 " %" PRId64 " %d %d %d %d %d %" PRIx64 "\n",
+                e->name, e->fileSize, e->mtime, e->width, e->height,
+                e->charcount, (int)e->weight, e->mappedCount, e->coveragePages);
+    }
+    if (fclose(f) != 0 || rename(tmpPath, path) != 0) remove(tmpPath);
+}
+
+// Довжина розширення файлу шрифту (нестиснутого чи .gz, його читає TryLoadPSFFont) або 0
+static size_t FontFamily_FontExtension(const char* fileName, size_t len) {
+    static const char* const extensions[] = { ".psf", ".psfu", ".psf.gz", ".psfu.gz" };
+    for (size_t i = 0; i < sizeof(extensions) / sizeof(extensions[0]); i++) {
+        size_t extLen = strlen(extensions[i]);
+        if (len > extLen && strcmp(fileName + len - extLen, extensions[i]) == 0) return extLen;
+    }
+    return 0;
+}
+
+// Належність файлу name (без розширення) до родини family: далі має йти розмір
+// ("Uni3-Terminus12x6") або "Bold" і розмір ("Uni3-TerminusBold18x10")
+static int FontFamily_MatchName(const char* name, const char* family, FontWeight* weight) {
+    size_t len = strlen(family);
+    if (strncmp(name, family, len) != 0) return 0;
+    const char* rest = name + len;
+    *weight = FONT_WEIGHT_REGULAR;
+    if (strncmp(rest, "Bold", 4) == 0) {
+        *weight = FONT_WEIGHT_BOLD;
+        rest += 4;
+    }
+    return isdigit((unsigned char)*rest) != 0;
+}
+
+FontFamily* FontFamily_LoadDirectory(const char* dir, const char* name) {
+    if (!dir || !name) return NULL;
+    DIR* d = opendir(dir);
+    if (!d) {
+        printf("Не вдалося відкрити каталог шрифтів: %s\n", dir);
+        return NULL;
+    }
+
+    char indexPath[4096];
+    snprintf(indexPath, sizeof(indexPath), "%s/%s", dir, FONT_FAMILY_INDEX_NAME);
+    FontIndex cached = { 0 };
+    FontIndex_Read(&cached, indexPath);
+
+    FontFamily* family = FontFamily_Create(name);
+    FontIndex fresh = { 0 };
+    int dirty = 0;
+
+    struct dirent* entry;
+    while (family && (entry = readdir(d)) != NULL) {
+        size_t len = strlen(entry->d_name);
+        size_t extLen = FontFamily_FontExtension(entry->d_name, len);
+        if (extLen == 0) continue;
+        if (len >= sizeof(((FontFaceInfo*)0)->name) || strchr(entry->d_name, ' ')) continue;
+
+        char path[4096];
+        if (snprintf(path, sizeof(path), "%s/%s", dir, entry->d_name) >= (int)sizeof(path)) continue;
+        struct stat st;
+        if (stat(path, &st) != 0 || !S_ISREG(st.st_mode)) continue;
+
+        char baseName[64];
+        memcpy(baseName, entry->d_name, len - extLen);
+        baseName[len - extLen] = '\0';
+        FontWeight weight = FONT_WEIGHT_REGULAR;
+        int member = FontFamily_MatchName(baseName, name, &weight);
+
+        // Актуальний запис індексу знімає потребу відкривати файл
+        FontFaceInfo* info = FontIndex_Append(&fresh);
+        if (!info) continue;
+        const FontFaceInfo* known = FontIndex_Find(&cached, entry->d_name);
+        PSF_Font font;
+        int loaded = 0;
+        if (known && known->fileSize == (int64_t)st.st_size && known->mtime == (int64_t)st.st_mtime) {
+            *info = *known;
+        } else {
+            if (!TryLoadPSFFont(path, &font)) {
+                fresh.count--;
+                continue;
+            }
+            loaded = 1;
+            dirty = 1;
+            memcpy(info->name, entry->d_name, len + 1);
+            info->fileSize = (int64_t)st.st_size;
+            info->mtime = (int64_t)st.st_mtime;
+            // Як і пакувальник шрифтів: насиченість — з імені файлу
+            info->weight = strstr(baseName, "Bold") ? FONT_WEIGHT_BOLD : FONT_WEIGHT_REGULAR;
+            FontFamily_FillInfo(info, &font);
+        }
+
+        if (!member) {
+            if (loaded) UnloadPSFFont(font);
+            continue;
+        }
+
+        FontFace face;
+        memset(&face, 0, sizeof(face));
+        face.info = *info;
+        face.info.weight = weight;
+        size_t pathLen = strlen(path) + 1;
+        face.path = malloc(pathLen);
+        if (face.path) memcpy(face.path, path, pathLen);
+        if (loaded) {
+            // Файл усе одно розібрано — тримаємо шрифт, а не читаємо його вдруге
+            face.owned = malloc(sizeof(PSF_Font));
+            if (face.owned) *face.owned = font;
+            else UnloadPSFFont(font);
+            face.font = face.owned;
+        }
+        if (FontFamily_Insert(family, &face) < 0) {
+            FontFamily_FreeOwned(&face);
+            free(face.path);
+        }
+    }
+    closedir(d);
+
+    // Індекс перезаписується, лише якщо файли змінились, з’явились або зникли
+    if (fresh.count != cached.count) dirty = 1;
+    if (dirty) FontIndex_Write(&fresh, indexPath);
+    free(cached.entries);
+    free(fresh.entries);
+
+    if (family && family->faceCount == 0) {
+        FontFamily_Destroy(family);
+        return NULL;
+    }
+    return family;
+}
+
+// ---------------------------------------------------------------------------
+// Вибір розміру
+// ---------------------------------------------------------------------------
+
+// Найбільший нативний розмір насиченості weight, що вміщається у targetHeight
+// (інакше найменший); -1, якщо такої насиченості немає
+static int FontFamily_Choose(const FontFamily* family, int targetHeight, FontWeight weight) {
+    int best = -1;
+    for (int i = 0; i < family->faceCount; i++) {
+        const FontFace* face = &family->faces[i];
+        if (face->info.weight != weight || face->loadFailed) continue;
+        if (best < 0 || face->info.height <= targetHeight) best = i;
+    }
+    return best;
+}
+
+// Завантажує шрифт з каталогу при першому виборі; 0 — файл зник або пошкоджений
+static int FontFamily_EnsureLoaded(FontFamily* family, FontFace* face) {
+    if (face->font) return 1;
+    PSF_Font font;
+    if (face->path && TryLoadPSFFont(face->path, &font)) {
+        face->owned = malloc(sizeof(PSF_Font));
+        if (face->owned) {
+            *face->owned = font;
+            face->font = face->owned;
+            return 1;
+        }
+        UnloadPSFFont(font);
+    }
+    printf("Не вдалося завантажити шрифт родини: %s\n", face->path ? face->path : face->info.name);
+    face->loadFailed = 1;
+    FontFamily_ResetCache(family);
+    return 0;
+}
+
+FontSizeChoice FontFamily_SelectWeight(FontFamily* family, int targetHeight, FontWeight weight) {
+    FontSizeChoice choice = { NULL, 1, 1.0f };
+    if (!family || family->faceCount == 0 || targetHeight <= 0) return choice;
+    if (weight < 0 || weight >= FONT_WEIGHT_COUNT) weight = FONT_WEIGHT_REGULAR;
+
+    int face;
+    for (;;) {
+        int16_t* cached = targetHeight < FONT_FAMILY_CACHED_HEIGHTS ? &family->cachedFace[weight][targetHeight] : NULL;
+        face = cached ? *cached : FONT_FAMILY_NO_CHOICE;
+        if (face == FONT_FAMILY_NO_CHOICE) {
+            face = FontFamily_Choose(family, targetHeight, weight);
+            if (face < 0 && weight != FONT_WEIGHT_REGULAR) {
+                face = FontFamily_Choose(family, targetHeight, FONT_WEIGHT_REGULAR);
+            }
+            if (face < 0) return choice;
+            if (cached) *cached = (int16_t)face;
+        }
+        // Невдале завантаження вилучає розмір і скидає кеш — вибираємо серед решти
+        if (FontFamily_EnsureLoaded(family, &family->faces[face])) break;
+    }
+
+    choice.font = family->faces[face].font;
+    choice.scale = targetHeight / choice.font->height;
+    if (choice.scale < 1) choice.scale = 1;
+    choice.fractionalScale = (float)targetHeight / (float)choice.font->height;
+    return choice;
+}
+
+FontSizeChoice FontFamily_Select(FontFamily* family, int targetHeight) {
+    return FontFamily_SelectWeight(family, targetHeight, FONT_WEIGHT_REGULAR);
+}
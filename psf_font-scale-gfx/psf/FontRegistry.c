@@ -0,0 +1,217 @@
+// FontRegistry.c
+// Реєстр шрифтів з дескрипторами, усуненням дублікатів за вмістом і лічильником посилань.
+// Не потокобезпечний: викликається з потоку, що малює (фонове завантаження — через
+// AsyncFontLoader, готовий шрифт передається сюди FontRegistry_Adopt).
+#include "FontRegistry.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Комірка реєстру. Комірки виділяються окремо, тому вказівник на шрифт
+// не змінюється при збільшенні масиву.
+typedef struct {
+    PSF_Font font;
+    uint64_t hash;           // Хеш гліфів і Unicode-таблиці (0 — не обчислено, посторінковий шрифт)
+    char* name;              // Шлях або ім’я шрифту (може бути NULL)
+    int refCount;            // 0 — комірка вільна
+    uint32_t generation;     // Поточне покоління комірки (ніколи не 0)
+} FontRegistrySlot;
+
+static FontRegistrySlot** g_slots = NULL;
+static int g_slotCount = 0;
+static int g_slotCapacity = 0;
+
+// FNV-1a, 64 біти
+#define FNV64_OFFSET 0xcbf29ce484222325ULL
+#define FNV64_PRIME  0x100000001b3ULL
+
+static uint64_t FontRegistry_HashBytes(uint64_t hash, const void* data, size_t size) {
+    const unsigned char* p = (const unsigned char*)data;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= p[i];
+        hash *= FNV64_PRIME;
+    }
+    return hash;
+}
+
+// Хеш вмісту шрифту: розміри, гліфи та Unicode-таблиця (шрифти з однаковими гліфами,
+// але різними таблицями малюють різний текст). Посторінковий шрифт не хешується —
+// це означало б прочитати з диска всі його гліфи.
+static uint64_t FontRegistry_HashFont(const PSF_Font* font) {
+    if (!font->glyphBuffer) return 0;
+
+    int dims[4] = { font->width, font->height, font->charcount, font->charsize };
+    uint64_t hash = FontRegistry_HashBytes(FNV64_OFFSET, dims, sizeof(dims));
+    hash = FontRegistry_HashBytes(hash, font->glyphBuffer, (size_t)font->charcount * font->charsize);
+    if (font->unicodeTable) {
+        const UnicodeTable* table = font->unicodeTable;
+        hash = FontRegistry_HashBytes(hash, table->pageIndex, sizeof(table->pageIndex));
+        hash = FontRegistry_HashBytes(hash, table->pages, (size_t)table->pageCount * sizeof(table->pages[0]));
+    }
+    return hash ? hash : 1;
+}
+
+// Точне порівняння вмісту після збігу хешів
+static int FontRegistry_SameContent(const PSF_Font* a, const PSF_Font* b) {
+    if (a->width != b->width || a->height != b->height ||
+        a->charcount != b->charcount || a->charsize != b->charsize) return 0;
+    if (memcmp(a->glyphBuffer, b->glyphBuffer, (size_t)a->charcount * a->charsize) != 0) return 0;
+    if (!a->unicodeTable || !b->unicodeTable) return a->unicodeTable == b->unicodeTable;
+
+    const UnicodeTable* ta = a->unicodeTable;
+    const UnicodeTable* tb = b->unicodeTable;
+    return ta->pageCount == tb->pageCount &&
+           memcmp(ta->pageIndex, tb->pageIndex, sizeof(ta->pageIndex)) == 0 &&
+           memcmp(ta->pages, tb->pages, (size_t)ta->pageCount * sizeof(ta->pages[0])) == 0;
+}
+
+// Комірка за дескриптором або NULL, якщо дескриптор застарів
+static FontRegistrySlot* FontRegistry_Lookup(FontHandle handle) {
+    if (handle.generation == 0 || handle.index >= (uint32_t)g_slotCount) return NULL;
+    FontRegistrySlot* slot = g_slots[handle.index];
+    if (slot->refCount == 0 || slot->generation != handle.generation) return NULL;
+    return slot;
+}
+
+static FontHandle FontRegistry_HandleOf(int index) {
+    FontHandle handle = { (uint32_t)index, g_slots[index]->generation };
+    return handle;
+}
+
+// Вільна комірка (спершу звільнені, потім нова), -1 — немає пам’яті
+static int FontRegistry_FreeSlot(void) {
+    for (int i = 0; i < g_slotCount; i++) {
+        if (g_slots[i]->refCount == 0) return i;
+    }
+
+    if (g_slotCount == g_slotCapacity) {
+        int capacity = g_slotCapacity ? g_slotCapacity * 2 : 8;
+        FontRegistrySlot** slots = (FontRegistrySlot**)realloc(g_slots, capacity * sizeof(*slots));
+        if (!slots) return -1;
+        g_slots = slots;
+        g_slotCapacity = capacity;
+    }
+
+    FontRegistrySlot* slot = (FontRegistrySlot*)calloc(1, sizeof(FontRegistrySlot));
+    if (!slot) return -1;
+    slot->generation = 1;
+    g_slots[g_slotCount] = slot;
+    return g_slotCount++;
+}
+
+// Копія рядка (strdup не входить у C17)
+static char* FontRegistry_CopyName(const char* name) {
+    if (!name) return NULL;
+    size_t len = strlen(name) + 1;
+    char* copy = (char*)malloc(len);
+    if (copy) memcpy(copy, name, len);
+    return copy;
+}
+
+FontHandle FontRegistry_Adopt(PSF_Font font, const char* name) {
+    uint64_t hash = FontRegistry_HashFont(&font);
+
+    if (hash) {
+        for (int i = 0; i < g_slotCount; i++) {
+            FontRegistrySlot* slot = g_slots[i];
+            if (slot->refCount > 0 && slot->hash == hash && FontRegistry_SameContent(&slot->font, &font)) {
+                // Дублікат: залишаємо наявну копію разом з її кешами
+                UnloadPSFFont(font);
+                slot->refCount++;
+                return FontRegistry_HandleOf(i);
+            }
+        }
+    }
+
+    int index = FontRegistry_FreeSlot();
+    if (index < 0) {
+        printf("Не вдалося виділити пам’ять для реєстру шрифтів\n");
+        UnloadPSFFont(font);
+        return FONT_HANDLE_NONE;
+    }
+
+    FontRegistrySlot* slot = g_slots[index];
+    slot->font = font;
+    slot->hash = hash;
+    slot->name = FontRegistry_CopyName(name);
+    slot->refCount = 1;
+    return FontRegistry_HandleOf(index);
+}
+
+FontHandle FontRegistry_Load(const char* filename) {
+    // Той самий файл не читається вдруге
+    for (int i = 0; i < g_slotCount; i++) {
+        FontRegistrySlot* slot = g_slots[i];
+        if (slot->refCount > 0 && slot->name && strcmp(slot->name, filename) == 0) {
+            slot->refCount++;
+            return FontRegistry_HandleOf(i);
+        }
+    }
+
+    PSF_Font font;
+    if (!TryLoadPSFFont(filename, &font)) return FONT_HANDLE_NONE;
+    return FontRegistry_Adopt(font, filename);
+}
+
+const PSF_Font* FontRegistry_Get(FontHandle handle) {
+    FontRegistrySlot* slot = FontRegistry_Lookup(handle);
+    return slot ? &slot->font : NULL;
+}
+
+int FontRegistry_IsValid(FontHandle handle) {
+    return FontRegistry_Lookup(handle) != NULL;
+}
+
+FontHandle FontRegistry_Retain(FontHandle handle) {
+    FontRegistrySlot* slot = FontRegistry_Lookup(handle);
+    if (!slot) return FONT_HANDLE_NONE;
+    slot->refCount++;
+    return handle;
+}
+
+// Остаточне звільнення шрифту комірки
+static void FontRegistry_FreeFont(FontRegistrySlot* slot) {
+    UnloadPSFFont(slot->font);
+    free(slot->name);
+    slot->name = NULL;
+    slot->hash = 0;
+    slot->refCount = 0;
+    memset(&slot->font, 0, sizeof(slot->font));
+    // Нове покоління робить недійсними всі видані дескриптори комірки
+    if (++slot->generation == 0) slot->generation = 1;
+}
+
+void FontRegistry_Release(FontHandle handle) {
+    FontRegistrySlot* slot = FontRegistry_Lookup(handle);
+    if (!slot) return;
+    if (--slot->refCount == 0) FontRegistry_FreeFont(slot);
+}
+
+const char* FontRegistry_GetName(FontHandle handle) {
+    FontRegistrySlot* slot = FontRegistry_Lookup(handle);
+    return slot ? slot->name : NULL;
+}
+
+int FontRegistry_Reload(FontHandle handle, PSF_Font font) {
+    FontRegistrySlot* slot = FontRegistry_Lookup(handle);
+    if (!slot) {
+        UnloadPSFFont(font);
+        return -1;
+    }
+    int changed = ReloadPSFFontInPlace(&slot->font, font);
+    slot->hash = FontRegistry_HashFont(&slot->font);
+    return changed;
+}
+
+int FontRegistry_RefCount(FontHandle handle) {
+    FontRegistrySlot* slot = FontRegistry_Lookup(handle);
+    return slot ? slot->refCount : 0;
+}
+
+void FontRegistry_Clear(void) {
+    // Комірки залишаються: їхні покоління мають пережити очищення,
+    // інакше старий дескриптор міг би збігтися з дескриптором нового шрифту
+    for (int i = 0; i < g_slotCount; i++) {
+        if (g_slots[i]->refCount > 0) FontRegistry_FreeFont(g_slots[i]);
+    }
+}
@@ -0,0 +1,39 @@
+// GlyphPager.h
+#ifndef GLYPH_PAGER_H
+#define GLYPH_PAGER_H
+
+#include <stddef.h>
+#include <sys/types.h>
+
+// Розмір сторінки гліфів у байтах (сторінка містить цілу кількість гліфів, мінімум один)
+#define GLYPH_PAGER_PAGE_BYTES 4096
+
+// Посторінкове завантаження гліфів великих шрифтів на вимогу:
+// блок гліфів читається з файлу лише при першому зверненні до будь-якого гліфа в ньому.
+typedef struct GlyphPager GlyphPager;
+
+// Статистика сторінок
+typedef struct {
+    int pageCount;            // Усього сторінок у шрифті
+    int glyphsPerPage;        // Гліфів на сторінці
+    int residentPages;        // Сторінок зараз у пам’яті
+    int maxResidentPages;     // Обмеження (0 — без обмеження)
+    unsigned long faults;     // Скільки разів сторінку довелося читати з файлу
+    unsigned long evictions;  // Скільки сторінок витіснено через обмеження
+} GlyphPagerStats;
+
+// Створює пейджер для гліфів, що лежать у файлі fd починаючи з glyphOffset.
+// Пейджер стає власником fd. maxResidentPages <= 0 — без обмеження.
+GlyphPager* GlyphPager_Create(int fd, off_t glyphOffset, int charcount, int charsize, int maxResidentPages);
+
+// Повертає дані гліфа (зчитуючи його сторінку за потреби) або NULL при помилці читання.
+// Якщо задано обмеження, вказівник дійсний лише до наступного виклику для цього пейджера.
+const unsigned char* GlyphPager_GetGlyph(GlyphPager* pager, int index);
+
+// Заповнює статистику сторінок
+void GlyphPager_GetStats(const GlyphPager* pager, GlyphPagerStats* stats);
+
+// Звільняє сторінки і закриває файл
+void GlyphPager_Free(GlyphPager* pager);
+
+#endif // GLYPH_PAGER_H
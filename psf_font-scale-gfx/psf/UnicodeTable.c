@@ -0,0 +1,67 @@
+// UnicodeTable.c
+#include "UnicodeTable.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Ініціалізує таблицю: усі діапазони вказують на спільну порожню сторінку 0
+void UnicodeTable_Init(UnicodeTable* table) {
+    if (!table) return;
+
+    memset(table->pageIndex, 0, sizeof(table->pageIndex));
+    table->pageCapacity = 4;
+    table->pages = malloc(table->pageCapacity * sizeof(*table->pages));
+    if (!table->pages) {
+        table->pageCapacity = 0;
+        table->pageCount = 0;
+        return;
+    }
+    // 0xFF у кожному байті дає UNICODE_TABLE_NONE у кожній комірці
+    memset(table->pages[0], 0xFF, sizeof(table->pages[0]));
+    table->pageCount = 1;
+}
+
+// Звільняє пам’ять сторінок
+void UnicodeTable_Free(UnicodeTable* table) {
+    if (!table) return;
+
+    free(table->pages);
+    table->pages = NULL;
+    table->pageCount = 0;
+    table->pageCapacity = 0;
+}
+
+// Додає відповідність codepoint → glyphIndex, за потреби виділяючи нову сторінку
+int UnicodeTable_Set(UnicodeTable* table, uint32_t codepoint, int glyphIndex) {
+    if (!table || table->pageCount == 0) return 0;
+    if ((codepoint >> 8) >= UNICODE_TABLE_PAGES) return 0;
+    if (glyphIndex < 0 || glyphIndex >= UNICODE_TABLE_NONE) return 0;
+
+    uint16_t page = table->pageIndex[codepoint >> 8];
+    if (page == 0) {
+        // Розширюємо масив сторінок при потребі
+        if (table->pageCount == table->pageCapacity) {
+            int newCapacity = table->pageCapacity * 2;
+            uint16_t (*newPages)[256] = realloc(table->pages, newCapacity * sizeof(*table->pages));
+            if (!newPages) return 0;
+            table->pages = newPages;
+            table->pageCapacity = newCapacity;
+        }
+        page = (uint16_t)table->pageCount++;
+        memset(table->pages[page], 0xFF, sizeof(table->pages[page]));
+        table->pageIndex[codepoint >> 8] = page;
+    }
+
+    // Перший запис має пріоритет (у PSF кілька гліфів можуть заявляти ту саму точку)
+    if (table->pages[page][codepoint & 0xFF] == UNICODE_TABLE_NONE) {
+        table->pages[page][codepoint & 0xFF] = (uint16_t)glyphIndex;
+    }
+    return 1;
+}
+
+// Пошук індексу гліфа: O(1), без сканування
+int UnicodeTable_Get(const UnicodeTable* table, uint32_t codepoint) {
+    if ((codepoint >> 8) >= UNICODE_TABLE_PAGES || !table->pages) return -1;
+
+    uint16_t glyph = table->pages[table->pageIndex[codepoint >> 8]][codepoint & 0xFF];
+    return (glyph == UNICODE_TABLE_NONE) ? -1 : (int)glyph;
+}
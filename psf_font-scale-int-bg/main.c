@@ -10,6 +10,7 @@
 #include "main.h"
 
 #include "psf_font.h"  // заголовок із парсером PSF
+#include "EmbeddedFonts.h" // вбудовані шрифти (make EMBED_FONTS=1)
 PSF_Font psfFont;      // Глобальна змінна для PSF шрифту
 PSF_Font psfFont12;    // Інший PSF шрифт
 
@@ -28,9 +29,12 @@ int main(void) {
 
     InitWindow(screenWidth, screenHeight, "Raylib Oscilloscope with Trigger and Scaling");
 
-    // Завантаження PSF шрифту (шлях до вашого файлу)
-    psfFont = LoadPSFFont("fonts/Uni3-TerminusBold32x16.psf");
-    psfFont12 = LoadPSFFont("fonts/Uni3-Terminus12x6.psf");
+    // Завантаження PSF шрифту (шлях до вашого файлу; у збірці EMBED_FONTS=1 — з пам’яті програми)
+    psfFont = LoadPSFFontEmbedded("fonts/Uni3-TerminusBold32x16.psf");
+    psfFont12 = LoadPSFFontEmbedded("fonts/Uni3-Terminus12x6.psf");
+    // Бекенд заливає прямокутники: гліф малюється кількома заливками замість пікселів
+    BuildPSFGlyphRects(&psfFont);
+    BuildPSFGlyphRects(&psfFont12);
 
     SetTargetFPS(60);
 
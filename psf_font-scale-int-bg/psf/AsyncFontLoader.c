@@ -0,0 +1,217 @@
+// AsyncFontLoader.c
+#include "AsyncFontLoader.h"
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>         // Для sysconf (кількість ядер)
+
+#define ASYNC_FONT_MAX_WORKERS 4
+
+// Одне завдання завантаження
+typedef struct {
+    char* filename;          // Копія шляху до файлу
+    AsyncFontStatus status;  // Поточний стан
+    PSF_Font font;           // Результат (дійсний при ASYNC_FONT_READY)
+    int taken;               // 1 — шрифт уже передано викликачу
+} AsyncFontJob;
+
+struct AsyncFontLoader {
+    pthread_mutex_t lock;
+    pthread_cond_t workAvailable;  // Сигнал робочим потокам: з’явилось завдання або зупинка
+    pthread_cond_t jobDone;        // Сигнал очікувачам: якесь завдання завершилось
+    AsyncFontJob* jobs;            // Завдання в порядку постановки
+    int jobCount;
+    int jobCapacity;
+    int nextJob;                   // Перше ще не взяте в роботу завдання
+    int stopping;                  // 1 — потоки мають завершитись
+    pthread_t workers[ASYNC_FONT_MAX_WORKERS];
+    int workerCount;
+};
+
+// Робочий потік: бере завдання по черзі, читає й розбирає файл без утримання блокування
+static void* AsyncFontLoader_Worker(void* arg) {
+    AsyncFontLoader* loader = (AsyncFontLoader*)arg;
+
+    pthread_mutex_lock(&loader->lock);
+    for (;;) {
+        while (!loader->stopping && loader->nextJob >= loader->jobCount) {
+            pthread_cond_wait(&loader->workAvailable, &loader->lock);
+        }
+        if (loader->stopping) break;
+
+        int index = loader->nextJob++;
+        // Масив jobs може бути перевиділено під час завантаження, тому беремо копію шляху
+        char* filename = loader->jobs[index].filename;
+        pthread_mutex_unlock(&loader->lock);
+
+        PSF_Font font;
+        int ok = TryLoadPSFFont(filename, &font);
+
+        pthread_mutex_lock(&loader->lock);
+        AsyncFontJob* job = &loader->jobs[index];
+        if (ok) job->font = font;
+        job->status = ok ? ASYNC_FONT_READY : ASYNC_FONT_FAILED;
+        pthread_cond_broadcast(&loader->jobDone);
+    }
+    pthread_mutex_unlock(&loader->lock);
+    return NULL;
+}
+
+AsyncFontLoader* AsyncFontLoader_Create(int workerCount) {
+    if (workerCount <= 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        workerCount = cpus > 0 ? (int)cpus : 1;
+    }
+    if (workerCount > ASYNC_FONT_MAX_WORKERS) workerCount = ASYNC_FONT_MAX_WORKERS;
+
+    AsyncFontLoader* loader = calloc(1, sizeof(AsyncFontLoader));
+    if (!loader) return NULL;
+
+    pthread_mutex_init(&loader->lock, NULL);
+    pthread_cond_init(&loader->workAvailable, NULL);
+    pthread_cond_init(&loader->jobDone, NULL);
+
+    for (int i = 0; i < workerCount; i++) {
+        if (pthread_create(&loader->workers[loader->workerCount], NULL, AsyncFontLoader_Worker, loader) == 0) {
+            loader->workerCount++;
+        }
+    }
+    if (loader->workerCount == 0) {
+        AsyncFontLoader_Destroy(loader);
+        return NULL;
+    }
+    return loader;
+}
+
+AsyncFontHandle AsyncFontLoader_Submit(AsyncFontLoader* loader, const char* filename) {
+    if (!loader || !filename) return -1;
+
+    char* copy = strdup(filename);
+    if (!copy) return -1;
+
+    pthread_mutex_lock(&loader->lock);
+    if (loader->jobCount == loader->jobCapacity) {
+        int newCapacity = loader->jobCapacity ? loader->jobCapacity * 2 : 16;
+        AsyncFontJob* jobs = realloc(loader->jobs, newCapacity * sizeof(AsyncFontJob));
+        if (!jobs) {
+            pthread_mutex_unlock(&loader->lock);
+            free(copy);
+            return -1;
+        }
+        loader->jobs = jobs;
+        loader->jobCapacity = newCapacity;
+    }
+
+    AsyncFontHandle handle = loader->jobCount++;
+    AsyncFontJob* job = &loader->jobs[handle];
+    memset(job, 0, sizeof(*job));
+    job->filename = copy;
+    job->status = ASYNC_FONT_PENDING;
+
+    pthread_cond_signal(&loader->workAvailable);
+    pthread_mutex_unlock(&loader->lock);
+    return handle;
+}
+
+int AsyncFontLoader_SubmitList(AsyncFontLoader* loader, const char* const* filenames, int count,
+                               AsyncFontHandle* handles) {
+    int submitted = 0;
+    for (int i = 0; i < count; i++) {
+        AsyncFontHandle handle = AsyncFontLoader_Submit(loader, filenames[i]);
+        if (handles) handles[i] = handle;
+        if (handle >= 0) submitted++;
+    }
+    return submitted;
+}
+
+// Передає готовий шрифт викликачу (викликається під блокуванням).
+// Другий власник того самого буфера гліфів означав би подвійний UnloadPSFFont,
+// тому вже переданий шрифт не видається знову.
+static AsyncFontStatus AsyncFontLoader_Take(AsyncFontJob* job, PSF_Font* out) {
+    if (job->status != ASYNC_FONT_READY) return job->status;
+    if (job->taken) return ASYNC_FONT_TAKEN;
+    if (out) {
+        *out = job->font;
+        job->taken = 1;
+    }
+    return ASYNC_FONT_READY;
+}
+
+AsyncFontStatus AsyncFontLoader_Poll(AsyncFontLoader* loader, AsyncFontHandle handle) {
+    if (!loader) return ASYNC_FONT_INVALID;
+
+    pthread_mutex_lock(&loader->lock);
+    AsyncFontStatus status = ASYNC_FONT_INVALID;
+    if (handle >= 0 && handle < loader->jobCount) {
+        AsyncFontJob* job = &loader->jobs[handle];
+        status = (job->status == ASYNC_FONT_READY && job->taken) ? ASYNC_FONT_TAKEN : job->status;
+    }
+    pthread_mutex_unlock(&loader->lock);
+    return status;
+}
+
+AsyncFontStatus AsyncFontLoader_TryGet(AsyncFontLoader* loader, AsyncFontHandle handle, PSF_Font* out) {
+    if (!loader) return ASYNC_FONT_INVALID;
+
+    pthread_mutex_lock(&loader->lock);
+    AsyncFontStatus status = ASYNC_FONT_INVALID;
+    if (handle >= 0 && handle < loader->jobCount) {
+        status = AsyncFontLoader_Take(&loader->jobs[handle], out);
+    }
+    pthread_mutex_unlock(&loader->lock);
+    return status;
+}
+
+AsyncFontStatus AsyncFontLoader_Wait(AsyncFontLoader* loader, AsyncFontHandle handle, PSF_Font* out) {
+    if (!loader) return ASYNC_FONT_INVALID;
+
+    pthread_mutex_lock(&loader->lock);
+    AsyncFontStatus status = ASYNC_FONT_INVALID;
+    if (handle >= 0 && handle < loader->jobCount) {
+        while (loader->jobs[handle].status == ASYNC_FONT_PENDING) {
+            pthread_cond_wait(&loader->jobDone, &loader->lock);
+        }
+        status = AsyncFontLoader_Take(&loader->jobs[handle], out);
+    }
+    pthread_mutex_unlock(&loader->lock);
+    return status;
+}
+
+void AsyncFontLoader_WaitAll(AsyncFontLoader* loader) {
+    if (!loader) return;
+
+    pthread_mutex_lock(&loader->lock);
+    for (int i = 0; i < loader->jobCount; i++) {
+        while (loader->jobs[i].status == ASYNC_FONT_PENDING) {
+            pthread_cond_wait(&loader->jobDone, &loader->lock);
+        }
+    }
+    pthread_mutex_unlock(&loader->lock);
+}
+
+void AsyncFontLoader_Destroy(AsyncFontLoader* loader) {
+    if (!loader) return;
+
+    pthread_mutex_lock(&loader->lock);
+    loader->stopping = 1;
+    pthread_cond_broadcast(&loader->workAvailable);
+    pthread_mutex_unlock(&loader->lock);
+
+    for (int i = 0; i < loader->workerCount; i++) {
+        pthread_join(loader->workers[i], NULL);
+    }
+
+    for (int i = 0; i < loader->jobCount; i++) {
+        AsyncFontJob* job = &loader->jobs[i];
+        if (job->status == ASYNC_FONT_READY && !job->taken) {
+            UnloadPSFFont(job->font);
+        }
+        free(job->filename);
+    }
+    free(loader->jobs);
+
+    pthread_cond_destroy(&loader->jobDone);
+    pthread_cond_destroy(&loader->workAvailable);
+    pthread_mutex_destroy(&loader->lock);
+    free(loader);
+}
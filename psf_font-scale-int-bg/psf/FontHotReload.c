@@ -0,0 +1,220 @@
+// FontHotReload.c
+#include "FontHotReload.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <poll.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/inotify.h>
+
+// Події, після яких файл шрифту вже записано повністю
+#define FONT_HOT_RELOAD_EVENTS (IN_CLOSE_WRITE | IN_MOVED_TO)
+
+// Шрифт під спостереженням
+typedef struct {
+    FontHandle handle;
+    char* path;              // Шлях до файлу (для TryLoadPSFFont у фоновому потоці)
+    const char* base;        // Ім’я файлу без каталогу (вказує всередину path)
+    int wd;                  // Дескриптор спостереження за каталогом файлу
+    PSF_Font pending;        // Завантажена нова версія, ще не застосована
+    int hasPending;
+} FontWatch;
+
+struct FontHotReload {
+    pthread_mutex_t lock;
+    int inotifyFd;
+    int wakePipe[2];          // Запис у wakePipe[1] будить потік для зупинки
+    FontWatch* watches;
+    int watchCount;
+    int watchCapacity;
+    PSF_Font* discarded;      // Версії, замінені новішими до Poll (звільняються в потоці кадру)
+    int discardedCount;
+    int discardedCapacity;
+    pthread_t thread;
+};
+
+// Додає замінену версію до списку на звільнення (блокування вже взято)
+static void FontHotReload_Discard(FontHotReload* reload, PSF_Font font) {
+    if (reload->discardedCount == reload->discardedCapacity) {
+        int capacity = reload->discardedCapacity ? reload->discardedCapacity * 2 : 4;
+        PSF_Font* discarded = realloc(reload->discarded, capacity * sizeof(PSF_Font));
+        if (!discarded) return;  // Краще втратити пам’ять шрифту, ніж звільнити його не в тому потоці
+        reload->discarded = discarded;
+        reload->discardedCapacity = capacity;
+    }
+    reload->discarded[reload->discardedCount++] = font;
+}
+
+// Завантажує змінений файл спостереження index без утримання блокування
+static void FontHotReload_LoadChanged(FontHotReload* reload, int index) {
+    pthread_mutex_lock(&reload->lock);
+    // Масив watches може бути перевиділено, але рядок шляху живе до Destroy
+    const char* path = reload->watches[index].path;
+    pthread_mutex_unlock(&reload->lock);
+
+    PSF_Font font;
+    if (!TryLoadPSFFont(path, &font)) return;  // Файл ще дописується — дочекаємось наступної події
+
+    pthread_mutex_lock(&reload->lock);
+    FontWatch* watch = &reload->watches[index];
+    if (watch->hasPending) FontHotReload_Discard(reload, watch->pending);
+    watch->pending = font;
+    watch->hasPending = 1;
+    pthread_mutex_unlock(&reload->lock);
+}
+
+// Потік спостереження: чекає подій inotify і розбирає змінені шрифти
+static void* FontHotReload_Thread(void* arg) {
+    FontHotReload* reload = (FontHotReload*)arg;
+    char buffer[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+
+    for (;;) {
+        struct pollfd fds[2] = {
+            { reload->inotifyFd, POLLIN, 0 },
+            { reload->wakePipe[0], POLLIN, 0 },
+        };
+        if (poll(fds, 2, -1) < 0) continue;
+        if (fds[1].revents) break;
+
+        ssize_t len = read(reload->inotifyFd, buffer, sizeof(buffer));
+        for (ssize_t offset = 0; offset < len; ) {
+            const struct inotify_event* event = (const struct inotify_event*)(buffer + offset);
+            offset += sizeof(struct inotify_event) + event->len;
+            if (!(event->mask & FONT_HOT_RELOAD_EVENTS) || event->len == 0) continue;
+
+            pthread_mutex_lock(&reload->lock);
+            int count = reload->watchCount;
+            pthread_mutex_unlock(&reload->lock);
+
+            for (int i = 0; i < count; i++) {
+                pthread_mutex_lock(&reload->lock);
+                int match = reload->watches[i].wd == event->wd &&
+                            strcmp(reload->watches[i].base, event->name) == 0;
+                pthread_mutex_unlock(&reload->lock);
+                if (match) FontHotReload_LoadChanged(reload, i);
+            }
+        }
+    }
+    return NULL;
+}
+
+FontHotReload* FontHotReload_Create(void) {
+    FontHotReload* reload = calloc(1, sizeof(FontHotReload));
+    if (!reload) return NULL;
+
+    reload->inotifyFd = inotify_init1(IN_CLOEXEC | IN_NONBLOCK);
+    if (reload->inotifyFd < 0 || pipe(reload->wakePipe) != 0) {
+        printf("Не вдалося запустити спостереження за файлами шрифтів\n");
+        if (reload->inotifyFd >= 0) close(reload->inotifyFd);
+        free(reload);
+        return NULL;
+    }
+
+    pthread_mutex_init(&reload->lock, NULL);
+    if (pthread_create(&reload->thread, NULL, FontHotReload_Thread, reload) != 0) {
+        close(reload->inotifyFd);
+        close(reload->wakePipe[0]);
+        close(reload->wakePipe[1]);
+        pthread_mutex_destroy(&reload->lock);
+        free(reload);
+        return NULL;
+    }
+    return reload;
+}
+
+int FontHotReload_Watch(FontHotReload* reload, FontHandle handle) {
+    const char* name = FontRegistry_GetName(handle);
+    if (!reload || !name) return 0;
+
+    size_t len = strlen(name) + 1;
+    char* path = malloc(len);
+    if (!path) return 0;
+    memcpy(path, name, len);
+
+    // Спостерігаємо за каталогом: редактори часто зберігають через новий файл + rename
+    const char* slash = strrchr(path, '/');
+    const char* base = slash ? slash + 1 : path;
+    char dir[4096] = ".";
+    if (slash) {
+        size_t dirLen = (slash == path) ? 1 : (size_t)(slash - path);
+        if (dirLen >= sizeof(dir)) { free(path); return 0; }
+        memcpy(dir, path, dirLen);
+        dir[dirLen] = '\0';
+    }
+
+    int wd = inotify_add_watch(reload->inotifyFd, dir, FONT_HOT_RELOAD_EVENTS);
+    if (wd < 0) {
+        printf("Не вдалося стежити за каталогом шрифту: %s\n", dir);
+        free(path);
+        return 0;
+    }
+
+    pthread_mutex_lock(&reload->lock);
+    if (reload->watchCount == reload->watchCapacity) {
+        int capacity = reload->watchCapacity ? reload->watchCapacity * 2 : 8;
+        FontWatch* watches = realloc(reload->watches, capacity * sizeof(FontWatch));
+        if (!watches) {
+            pthread_mutex_unlock(&reload->lock);
+            free(path);
+            return 0;
+        }
+        reload->watches = watches;
+        reload->watchCapacity = capacity;
+    }
+    FontWatch* watch = &reload->watches[reload->watchCount++];
+    memset(watch, 0, sizeof(*watch));
+    watch->handle = handle;
+    watch->path = path;
+    watch->base = base;
+    watch->wd = wd;
+    pthread_mutex_unlock(&reload->lock);
+    return 1;
+}
+
+int FontHotReload_Poll(FontHotReload* reload) {
+    if (!reload) return 0;
+    // Фоновий потік тримає блокування лише на час обміну вказівниками,
+    // але й цього кадр не чекає
+    if (pthread_mutex_trylock(&reload->lock) != 0) return 0;
+
+    int reloaded = 0;
+    for (int i = 0; i < reload->watchCount; i++) {
+        FontWatch* watch = &reload->watches[i];
+        if (!watch->hasPending) continue;
+        watch->hasPending = 0;
+        // Порівняння і підміна гліфів — у потоці кадру, де живуть кеші
+        if (FontRegistry_Reload(watch->handle, watch->pending) >= 0) reloaded++;
+    }
+    for (int i = 0; i < reload->discardedCount; i++) {
+        UnloadPSFFont(reload->discarded[i]);
+    }
+    reload->discardedCount = 0;
+
+    pthread_mutex_unlock(&reload->lock);
+    return reloaded;
+}
+
+void FontHotReload_Destroy(FontHotReload* reload) {
+    if (!reload) return;
+
+    char stop = 1;
+    if (write(reload->wakePipe[1], &stop, 1) == 1) pthread_join(reload->thread, NULL);
+
+    for (int i = 0; i < reload->watchCount; i++) {
+        if (reload->watches[i].hasPending) UnloadPSFFont(reload->watches[i].pending);
+        free(reload->watches[i].path);
+    }
+    for (int i = 0; i < reload->discardedCount; i++) {
+        UnloadPSFFont(reload->discarded[i]);
+    }
+
+    close(reload->inotifyFd);
+    close(reload->wakePipe[0]);
+    close(reload->wakePipe[1]);
+    pthread_mutex_destroy(&reload->lock);
+    free(reload->watches);
+    free(reload->discarded);
+    free(reload);
+}
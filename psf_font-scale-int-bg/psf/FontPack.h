@@ -0,0 +1,49 @@
+// FontPack.h
+#ifndef FONT_PACK_H
+#define FONT_PACK_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "psf_font.h"
+#include "FontPackFormat.h"
+
+// Опис шрифту з індексу пакета
+typedef struct {
+    char name[FONT_PACK_NAME_LEN]; // Ім’я шрифту, напр. "Uni3-TerminusBold18x10"
+    int width;                     // Ширина гліфа в пікселях
+    int height;                    // Висота гліфа в пікселях
+    int style;                     // FONT_PACK_STYLE_*
+    int charcount;                 // Кількість гліфів
+    uint32_t offset;               // Початок PSF даних у пакеті
+    uint32_t size;                 // Розмір PSF даних
+} FontPackInfo;
+
+typedef struct FontPack FontPack;
+
+// Відкриває пакет: open + fstat + mmap + close незалежно від кількості шрифтів у ньому.
+// Читається лише індекс; гліфи шрифту розбираються при першому FontPack_GetFace.
+// Повертає NULL, якщо файл не вдалося відкрити або індекс пошкоджено.
+FontPack* FontPack_Open(const char* filename);
+
+// Знімає відображення і звільняє всі розібрані шрифти пакета
+void FontPack_Close(FontPack* pack);
+
+// Кількість шрифтів у пакеті
+int FontPack_FaceCount(const FontPack* pack);
+
+// Опис шрифту за індексом (NULL, якщо індекс поза межами)
+const FontPackInfo* FontPack_GetInfo(const FontPack* pack, int index);
+
+// Пошук шрифту за ім’ям ("Uni3-Terminus12x6" або "fonts/Uni3-Terminus12x6.psf"), -1 — немає
+int FontPack_FindByName(const FontPack* pack, const char* name);
+
+// Пошук шрифту за висотою і стилем, -1 — немає
+int FontPack_FindBySize(const FontPack* pack, int height, int style);
+
+// Шрифт за індексом; при першому зверненні розбирається на місці у відображенні пакета.
+// Вказівник дійсний до FontPack_Close, шрифт не можна передавати в UnloadPSFFont.
+// Повертає NULL, якщо індекс поза межами або дані шрифту пошкоджено.
+// Не потокобезпечна: перше звернення до шрифту має відбуватися з одного потоку.
+const PSF_Font* FontPack_GetFace(FontPack* pack, int index);
+
+#endif // FONT_PACK_H
@@ -0,0 +1,58 @@
+// FontRegistry.h
+#ifndef FONT_REGISTRY_H
+#define FONT_REGISTRY_H
+
+#include <stdint.h>
+#include "psf_font.h"
+
+// Дескриптор шрифту в реєстрі: номер комірки + покоління комірки.
+// Після остаточного звільнення шрифту покоління комірки збільшується, тож усі старі
+// дескриптори стають недійсними за O(1), навіть якщо комірку зайняв інший шрифт.
+typedef struct {
+    uint32_t index;
+    uint32_t generation;     // 0 — порожній дескриптор
+} FontHandle;
+
+// Порожній дескриптор (помилка завантаження)
+#define FONT_HANDLE_NONE ((FontHandle){ 0, 0 })
+
+// Завантажує шрифт з файлу або повертає вже завантажений:
+// той самий шлях чи шрифт з ідентичними гліфами і Unicode-таблицею отримує той самий
+// дескриптор (лічильник посилань +1) замість другої копії гліфів і других кешів.
+// Повертає FONT_HANDLE_NONE при помилці (програма не завершується).
+FontHandle FontRegistry_Load(const char* filename);
+
+// Передає реєстру вже завантажений шрифт (LoadPSFFontMapped, AsyncFontLoader тощо).
+// Якщо ідентичний шрифт уже є, font звільняється і повертається наявний дескриптор.
+// name — необов’язкове ім’я для пошуку через FontRegistry_Load (може бути NULL).
+FontHandle FontRegistry_Adopt(PSF_Font font, const char* name);
+
+// Шрифт за дескриптором або NULL, якщо дескриптор недійсний (шрифт уже звільнено).
+// Вказівник стабільний, доки шрифт є в реєстрі.
+const PSF_Font* FontRegistry_Get(FontHandle handle);
+
+// 1 — дескриптор указує на завантажений шрифт
+int FontRegistry_IsValid(FontHandle handle);
+
+// Додаткове посилання на шрифт (повертає той самий дескриптор)
+FontHandle FontRegistry_Retain(FontHandle handle);
+
+// Знімає посилання; останнє звільняє шрифт через UnloadPSFFont (кеші, прив’язані до
+// font.serial, очищаються обробниками AddPSFUnloadHook) і робить дескриптори недійсними
+void FontRegistry_Release(FontHandle handle);
+
+// Шлях (ім’я), з яким шрифт потрапив у реєстр, або NULL
+const char* FontRegistry_GetName(FontHandle handle);
+
+// Заміна шрифту новою версією на місці (див. ReloadPSFFontInPlace): дескриптор і вказівник
+// з FontRegistry_Get лишаються дійсними. Повертає кількість змінених гліфів або -1, якщо
+// дескриптор недійсний (тоді font звільняється).
+int FontRegistry_Reload(FontHandle handle, PSF_Font font);
+
+// Кількість посилань на шрифт (0 — дескриптор недійсний)
+int FontRegistry_RefCount(FontHandle handle);
+
+// Звільняє всі шрифти реєстру незалежно від лічильників посилань (усі дескриптори стають недійсними)
+void FontRegistry_Clear(void);
+
+#endif // FONT_REGISTRY_H
@@ -0,0 +1,386 @@
+// GlyphCompressor.c
+#include "GlyphCompressor.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Коди рядків у потоці гліфа (кожен код — один або кілька рядків):
+//   0x00..0x9F             — рядок словника 0..159 (найчастіші рядки)
+//   0xA0..0xBF             — повтор попереднього рядка 1..32 рази
+//   0xC0..0xEF, b          — рядок словника 160 + ((код - 0xC0) << 8 | b)
+//   0xF0..0xFF, b1, b2     — рядок словника 160 + 12288 + ((код - 0xF0) << 16 | b1 << 8 | b2)
+// Рядки після останнього непорожнього не кодуються — гліф перед розпакуванням обнуляється.
+#define CODE_SHORT_COUNT   0xA0
+#define CODE_REPEAT        0xA0
+#define CODE_REPEAT_MAX    32
+#define CODE_LONG          0xC0
+#define CODE_LONG_COUNT    (0x30 << 8)
+#define CODE_HUGE          0xF0
+#define CODE_HUGE_COUNT    (0x10 << 16)
+#define MAX_DICTIONARY_ROWS (CODE_SHORT_COUNT + CODE_LONG_COUNT + CODE_HUGE_COUNT)
+
+// Гліфів у блоці: зміщення блоку — 32 біти, зміщення гліфа в блоці — 16 бітів
+#define GLYPHS_PER_BLOCK   16
+
+// Найдовший код одного рядка в байтах
+#define MAX_CODE_BYTES     3
+
+struct GlyphCompressor {
+    int charcount;
+    int charsize;
+    int bytesPerRow;
+    int height;
+    unsigned char* dictionary;   // Унікальні рядки (по bytesPerRow байтів), найчастіші першими
+    int dictionaryRows;
+    unsigned char* codes;        // Коди всіх гліфів підряд
+    size_t codeBytes;
+    uint32_t* blockStart;        // Початок кодів кожного блоку з GLYPHS_PER_BLOCK гліфів
+    uint16_t* glyphOffset;       // Початок кодів гліфа відносно його блоку
+    // Кеш розпакованих гліфів з прямим відображенням: комірка = index & cacheMask
+    unsigned char* cache;
+    int32_t* cacheTag;           // Гліф у комірці (-1 — порожня)
+    int cacheMask;
+    unsigned long hits;
+    unsigned long decodes;
+};
+
+// ---------------------------------------------------------------------------
+// Словник рядків: відкрита адресація за хешем вмісту рядка
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    unsigned char* rows;         // Рядки в порядку появи
+    uint32_t* counts;            // Скільки разів рядок закодовано окремим кодом
+    int count;
+    int capacity;
+    int32_t* slots;              // Хеш-таблиця: номер рядка або -1
+    int slotMask;
+    int bytesPerRow;
+} RowDictionary;
+
+static uint32_t HashRow(const unsigned char* row, int bytesPerRow) {
+    uint32_t hash = 2166136261u;
+    for (int i = 0; i < bytesPerRow; i++) {
+        hash = (hash ^ row[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static int RowDictionary_Init(RowDictionary* dict, int bytesPerRow, int expectedRows) {
+    memset(dict, 0, sizeof(*dict));
+    dict->bytesPerRow = bytesPerRow;
+    int slots = 1024;
+    while (slots < expectedRows * 2) slots <<= 1;
+    dict->slots = (int32_t*)malloc((size_t)slots * sizeof(int32_t));
+    if (!dict->slots) return 0;
+    memset(dict->slots, 0xFF, (size_t)slots * sizeof(int32_t));
+    dict->slotMask = slots - 1;
+    return 1;
+}
+
+static void RowDictionary_Free(RowDictionary* dict) {
+    free(dict->rows);
+    free(dict->counts);
+    free(dict->slots);
+}
+
+// Подвоєння хеш-таблиці, коли вона заповнена наполовину
+static int RowDictionary_Grow(RowDictionary* dict) {
+    int slots = (dict->slotMask + 1) * 2;
+    int32_t* table = (int32_t*)malloc((size_t)slots * sizeof(int32_t));
+    if (!table) return 0;
+    memset(table, 0xFF, (size_t)slots * sizeof(int32_t));
+    for (int i = 0; i < dict->count; i++) {
+        uint32_t h = HashRow(dict->rows + (size_t)i * dict->bytesPerRow, dict->bytesPerRow) & (slots - 1);
+        while (table[h] >= 0) h = (h + 1) & (slots - 1);
+        table[h] = i;
+    }
+    free(dict->slots);
+    dict->slots = table;
+    dict->slotMask = slots - 1;
+    return 1;
+}
+
+// Номер рядка в словнику (додає новий) або -1 при нестачі пам’яті
+static int RowDictionary_Find(RowDictionary* dict, const unsigned char* row, int add) {
+    uint32_t h = HashRow(row, dict->bytesPerRow) & dict->slotMask;
+    while (dict->slots[h] >= 0) {
+        int i = dict->slots[h];
+        if (memcmp(dict->rows + (size_t)i * dict->bytesPerRow, row, dict->bytesPerRow) == 0) return i;
+        h = (h + 1) & dict->slotMask;
+    }
+    if (!add) return -1;
+
+    if (dict->count == dict->capacity) {
+        int capacity = dict->capacity ? dict->capacity * 2 : 256;
+        unsigned char* rows = (unsigned char*)realloc(dict->rows, (size_t)capacity * dict->bytesPerRow);
+        if (!rows) return -1;
+        dict->rows = rows;
+        uint32_t* counts = (uint32_t*)realloc(dict->counts, (size_t)capacity * sizeof(uint32_t));
+        if (!counts) return -1;
+        dict->counts = counts;
+        dict->capacity = capacity;
+    }
+    int i = dict->count++;
+    memcpy(dict->rows + (size_t)i * dict->bytesPerRow, row, dict->bytesPerRow);
+    dict->counts[i] = 0;
+    dict->slots[h] = i;
+    if (dict->count * 2 > dict->slotMask + 1 && !RowDictionary_Grow(dict)) return -1;
+    return i;
+}
+
+// Кількість рядків гліфа до останнього непорожнього включно
+static int EncodedRowCount(const unsigned char* glyph, int bytesPerRow, int height) {
+    for (int row = height - 1; row >= 0; row--) {
+        const unsigned char* bits = glyph + (size_t)row * bytesPerRow;
+        for (int b = 0; b < bytesPerRow; b++) {
+            if (bits[b]) return row + 1;
+        }
+    }
+    return 0;
+}
+
+// Рядок словника з частотою — для сортування (без спільного стану: шрифти стискаються й у фонових потоках)
+typedef struct {
+    uint32_t count;
+    int row;
+} RowFrequency;
+
+// Сортування рядків словника за спаданням частоти
+static int CompareRowFrequency(const void* a, const void* b) {
+    const RowFrequency* x = (const RowFrequency*)a;
+    const RowFrequency* y = (const RowFrequency*)b;
+    if (x->count != y->count) return x->count > y->count ? -1 : 1;
+    return x->row - y->row;
+}
+
+// Записує код рядка словника index; повертає кількість байтів
+static int EmitRowCode(unsigned char* out, int index) {
+    if (index < CODE_SHORT_COUNT) {
+        out[0] = (unsigned char)index;
+        return 1;
+    }
+    index -= CODE_SHORT_COUNT;
+    if (index < CODE_LONG_COUNT) {
+        out[0] = (unsigned char)(CODE_LONG + (index >> 8));
+        out[1] = (unsigned char)index;
+        return 2;
+    }
+    index -= CODE_LONG_COUNT;
+    out[0] = (unsigned char)(CODE_HUGE + (index >> 16));
+    out[1] = (unsigned char)(index >> 8);
+    out[2] = (unsigned char)index;
+    return 3;
+}
+
+GlyphCompressor* GlyphCompressor_Create(const unsigned char* glyphs, int charcount, int charsize,
+                                        int bytesPerRow, int height, int cacheSlots) {
+    if (!glyphs || charcount <= 0 || bytesPerRow <= 0 || height <= 0 ||
+        charsize < bytesPerRow * height) return NULL;
+    // Коди блоку мають уміститися в 16-бітові зміщення
+    if ((size_t)GLYPHS_PER_BLOCK * height * MAX_CODE_BYTES > 0xFFFF) return NULL;
+
+    // Прохід 1: словник рядків і частота кожного як окремого коду (повтори не рахуються)
+    RowDictionary dict;
+    if (!RowDictionary_Init(&dict, bytesPerRow, charcount)) return NULL;
+    for (int c = 0; c < charcount; c++) {
+        const unsigned char* glyph = glyphs + (size_t)c * charsize;
+        int rows = EncodedRowCount(glyph, bytesPerRow, height);
+        for (int row = 0; row < rows; row++) {
+            const unsigned char* bits = glyph + (size_t)row * bytesPerRow;
+            if (row > 0 && memcmp(bits, bits - bytesPerRow, bytesPerRow) == 0) continue;
+            int i = RowDictionary_Find(&dict, bits, 1);
+            if (i < 0 || dict.count > MAX_DICTIONARY_ROWS) {
+                RowDictionary_Free(&dict);
+                return NULL;
+            }
+            dict.counts[i]++;
+        }
+    }
+
+    GlyphCompressor* compressor = (GlyphCompressor*)calloc(1, sizeof(GlyphCompressor));
+    RowFrequency* order = (RowFrequency*)malloc(((size_t)dict.count + 1) * sizeof(RowFrequency));
+    int* rank = (int*)malloc(((size_t)dict.count + 1) * sizeof(int));
+    int blockCount = (charcount + GLYPHS_PER_BLOCK - 1) / GLYPHS_PER_BLOCK;
+    if (!compressor || !order || !rank) goto fail;
+
+    compressor->charcount = charcount;
+    compressor->charsize = charsize;
+    compressor->bytesPerRow = bytesPerRow;
+    compressor->height = height;
+
+    // Найчастіші рядки — першими, щоб отримати однобайтові коди
+    for (int i = 0; i < dict.count; i++) {
+        order[i].count = dict.counts[i];
+        order[i].row = i;
+    }
+    qsort(order, dict.count, sizeof(RowFrequency), CompareRowFrequency);
+    compressor->dictionaryRows = dict.count;
+    compressor->dictionary = (unsigned char*)malloc((size_t)(dict.count ? dict.count : 1) * bytesPerRow);
+    if (!compressor->dictionary) goto fail;
+    for (int i = 0; i < dict.count; i++) {
+        rank[order[i].row] = i;
+        memcpy(compressor->dictionary + (size_t)i * bytesPerRow,
+               dict.rows + (size_t)order[i].row * bytesPerRow, bytesPerRow);
+    }
+
+    // Прохід 2: коди гліфів
+    size_t capacity = (size_t)charcount * 4 + 64;
+    compressor->codes = (unsigned char*)malloc(capacity);
+    compressor->blockStart = (uint32_t*)malloc(((size_t)blockCount + 1) * sizeof(uint32_t));
+    compressor->glyphOffset = (uint16_t*)malloc((size_t)charcount * sizeof(uint16_t));
+    if (!compressor->codes || !compressor->blockStart || !compressor->glyphOffset) goto fail;
+
+    size_t size = 0;
+    for (int c = 0; c < charcount; c++) {
+        if (c % GLYPHS_PER_BLOCK == 0) {
+            if (size > UINT32_MAX) goto fail;
+            compressor->blockStart[c / GLYPHS_PER_BLOCK] = (uint32_t)size;
+        }
+        compressor->glyphOffset[c] = (uint16_t)(size - compressor->blockStart[c / GLYPHS_PER_BLOCK]);
+
+        const unsigned char* glyph = glyphs + (size_t)c * charsize;
+        int rows = EncodedRowCount(glyph, bytesPerRow, height);
+        if (size + (size_t)rows * MAX_CODE_BYTES > capacity) {
+            while (size + (size_t)rows * MAX_CODE_BYTES > capacity) capacity *= 2;
+            unsigned char* codes = (unsigned char*)realloc(compressor->codes, capacity);
+            if (!codes) goto fail;
+            compressor->codes = codes;
+        }
+
+        int run = 0;
+        for (int row = 0; row < rows; row++) {
+            const unsigned char* bits = glyph + (size_t)row * bytesPerRow;
+            if (row > 0 && memcmp(bits, bits - bytesPerRow, bytesPerRow) == 0) {
+                if (++run == CODE_REPEAT_MAX) {
+                    compressor->codes[size++] = (unsigned char)(CODE_REPEAT + run - 1);
+                    run = 0;
+                }
+                continue;
+            }
+            if (run) {
+                compressor->codes[size++] = (unsigned char)(CODE_REPEAT + run - 1);
+                run = 0;
+            }
+            size += EmitRowCode(compressor->codes + size, rank[RowDictionary_Find(&dict, bits, 0)]);
+        }
+        if (run) compressor->codes[size++] = (unsigned char)(CODE_REPEAT + run - 1);
+    }
+    compressor->blockStart[blockCount] = (uint32_t)size;
+    compressor->codeBytes = size;
+    // Зайва місткість буфера кодів більше не потрібна
+    unsigned char* shrunk = (unsigned char*)realloc(compressor->codes, size ? size : 1);
+    if (shrunk) compressor->codes = shrunk;
+
+    // Кеш розпакованих гліфів
+    int slots = 1;
+    int wanted = cacheSlots > 0 ? cacheSlots : GLYPH_COMPRESSOR_DEFAULT_CACHE;
+    while (slots < wanted && slots < (1 << 20)) slots <<= 1;
+    compressor->cache = (unsigned char*)malloc((size_t)slots * charsize);
+    compressor->cacheTag = (int32_t*)malloc((size_t)slots * sizeof(int32_t));
+    if (!compressor->cache || !compressor->cacheTag) goto fail;
+    memset(compressor->cacheTag, 0xFF, (size_t)slots * sizeof(int32_t));
+    compressor->cacheMask = slots - 1;
+
+    free(order);
+    free(rank);
+    RowDictionary_Free(&dict);
+    return compressor;
+
+fail:
+    free(order);
+    free(rank);
+    RowDictionary_Free(&dict);
+    GlyphCompressor_Free(compressor);
+    return NULL;
+}
+
+// Межі кодів гліфа index у потоці
+static size_t GlyphCodeStart(const GlyphCompressor* compressor, int index) {
+    if (index >= compressor->charcount) return compressor->codeBytes;
+    return compressor->blockStart[index / GLYPHS_PER_BLOCK] + compressor->glyphOffset[index];
+}
+
+// Розпакування гліфа index у out (charsize байтів)
+static void GlyphCompressor_Decode(const GlyphCompressor* compressor, int index, unsigned char* out) {
+    int bytesPerRow = compressor->bytesPerRow;
+    const unsigned char* code = compressor->codes + GlyphCodeStart(compressor, index);
+    const unsigned char* end = compressor->codes + GlyphCodeStart(compressor, index + 1);
+    unsigned char* row = out;
+    unsigned char* rowsEnd = out + (size_t)compressor->height * bytesPerRow;
+
+    memset(out, 0, compressor->charsize);
+    while (code < end) {
+        unsigned int c = *code++;
+        const unsigned char* src;
+        if (c < CODE_SHORT_COUNT) {
+            src = compressor->dictionary + (size_t)c * bytesPerRow;
+        } else if (c < CODE_LONG) {
+            // Повтор попереднього рядка (перший рядок гліфа повтором не буває)
+            int run = (int)(c - CODE_REPEAT) + 1;
+            if (row == out || row + (size_t)run * bytesPerRow > rowsEnd) return;
+            for (int i = 0; i < run; i++, row += bytesPerRow) {
+                memcpy(row, row - bytesPerRow, bytesPerRow);
+            }
+            continue;
+        } else if (c < CODE_HUGE) {
+            if (code >= end) return;
+            src = compressor->dictionary +
+                  (size_t)(CODE_SHORT_COUNT + ((c - CODE_LONG) << 8 | code[0])) * bytesPerRow;
+            code += 1;
+        } else {
+            if (end - code < 2) return;
+            src = compressor->dictionary +
+                  (size_t)(CODE_SHORT_COUNT + CODE_LONG_COUNT +
+                           ((c - CODE_HUGE) << 16 | code[0] << 8 | code[1])) * bytesPerRow;
+            code += 2;
+        }
+        if (row >= rowsEnd) return;
+        memcpy(row, src, bytesPerRow);
+        row += bytesPerRow;
+    }
+}
+
+const unsigned char* GlyphCompressor_GetGlyph(GlyphCompressor* compressor, int index) {
+    if (!compressor || index < 0 || index >= compressor->charcount) return NULL;
+
+    int slot = index & compressor->cacheMask;
+    unsigned char* data = compressor->cache + (size_t)slot * compressor->charsize;
+    if (compressor->cacheTag[slot] == index) {
+        compressor->hits++;
+        return data;
+    }
+    GlyphCompressor_Decode(compressor, index, data);
+    compressor->cacheTag[slot] = index;
+    compressor->decodes++;
+    return data;
+}
+
+void GlyphCompressor_GetStats(const GlyphCompressor* compressor, GlyphCompressorStats* stats) {
+    if (!stats) return;
+    memset(stats, 0, sizeof(*stats));
+    if (!compressor) return;
+
+    int blockCount = (compressor->charcount + GLYPHS_PER_BLOCK - 1) / GLYPHS_PER_BLOCK;
+    stats->rawBytes = (size_t)compressor->charcount * compressor->charsize;
+    stats->compressedBytes = (size_t)compressor->dictionaryRows * compressor->bytesPerRow +
+                             compressor->codeBytes +
+                             ((size_t)blockCount + 1) * sizeof(uint32_t) +
+                             (size_t)compressor->charcount * sizeof(uint16_t);
+    stats->cacheSlots = compressor->cacheMask + 1;
+    stats->cacheBytes = (size_t)stats->cacheSlots * (compressor->charsize + sizeof(int32_t));
+    stats->dictionaryRows = compressor->dictionaryRows;
+    stats->hits = compressor->hits;
+    stats->decodes = compressor->decodes;
+}
+
+void GlyphCompressor_Free(GlyphCompressor* compressor) {
+    if (!compressor) return;
+    free(compressor->dictionary);
+    free(compressor->codes);
+    free(compressor->blockStart);
+    free(compressor->glyphOffset);
+    free(compressor->cache);
+    free(compressor->cacheTag);
+    free(compressor);
+}
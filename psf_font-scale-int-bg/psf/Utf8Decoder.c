@@ -0,0 +1,224 @@
+// Utf8Decoder.c
+#include "Utf8Decoder.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define UTF8_DECODER_SSE2 1
+#endif
+
+#if defined(UTF8_DECODER_SSE2) && (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define UTF8_DECODER_AVX2 1
+#endif
+
+// Декодування однієї послідовності з перевіркою за таблицею коректних послідовностей Unicode
+// (розділ 3.9): другий байт має вужчі межі після E0, ED, F0 і F4. Повертає кількість байтів;
+// для некоректної — довжину її найдовшої коректної частини (щонайменше 1) і U+FFFD.
+static size_t DecodeSequence(const unsigned char* p, const unsigned char* end, uint32_t* codepoint) {
+    unsigned char c = p[0];
+    if (c < 0x80) {
+        *codepoint = c;
+        return 1;
+    }
+
+    int length;
+    uint32_t value;
+    unsigned char low = 0x80, high = 0xBF;   // Межі другого байта
+    if (c >= 0xC2 && c <= 0xDF) {
+        length = 2;
+        value = c & 0x1F;
+    } else if (c >= 0xE0 && c <= 0xEF) {
+        length = 3;
+        value = c & 0x0F;
+        if (c == 0xE0) low = 0xA0;           // Надлишкове кодування
+        if (c == 0xED) high = 0x9F;          // Сурогати U+D800..U+DFFF
+    } else if (c >= 0xF0 && c <= 0xF4) {
+        length = 4;
+        value = c & 0x07;
+        if (c == 0xF0) low = 0x90;           // Надлишкове кодування
+        if (c == 0xF4) high = 0x8F;          // Понад U+10FFFF
+    } else {
+        // Байт продовження без початку, C0/C1 або F5..FF
+        *codepoint = UTF8_REPLACEMENT;
+        return 1;
+    }
+
+    for (int i = 1; i < length; i++) {
+        if (p + i >= end || p[i] < low || p[i] > high) {
+            *codepoint = UTF8_REPLACEMENT;
+            return (size_t)i;
+        }
+        value = (value << 6) | (p[i] & 0x3F);
+        low = 0x80;
+        high = 0xBF;
+    }
+    *codepoint = value;
+    return (size_t)length;
+}
+
+// Звичайний цикл від p до stop (послідовність може виходити за stop, але не за end), поки в out
+// є місце. ASCII і двобайтові символи (кирилиця, латиниця з діакритикою) декодуються на місці,
+// решта — DecodeSequence. Повертає нову кількість символів.
+static size_t DecodeScalar(const unsigned char** pp, const unsigned char* stop, const unsigned char* end,
+                           uint32_t* out, size_t count, size_t capacity) {
+    const unsigned char* p = *pp;
+    // Кожен байт дає не більше одного символу: якщо місця в out досить на всі байти до stop,
+    // перевірка заповнення на кожному символі не потрібна
+    if (capacity - count < (size_t)(stop - p)) stop = p + (capacity - count);
+    while (p < stop) {
+        unsigned char c = p[0];
+        if (c < 0x80) {
+            out[count++] = c;
+            p++;
+        } else if (c >= 0xC2 && c <= 0xDF && end - p >= 2 && (p[1] & 0xC0) == 0x80) {
+            out[count++] = ((uint32_t)(c & 0x1F) << 6) | (p[1] & 0x3F);
+            p += 2;
+        } else {
+            p += DecodeSequence(p, end, &out[count++]);
+        }
+    }
+    *pp = p;
+    return count;
+}
+
+#ifdef UTF8_DECODER_SSE2
+// Блок з 16 байтів з не-ASCII. Якщо в ньому лише ASCII і цілі двобайтові послідовності
+// (кирилиця з пробілами й цифрами), значення всіх позицій обчислюються SSE2 без розгалужень
+// за видом символу, а позиції байтів продовження пропускаються; інакше — звичайний цикл.
+// Потребує 16 байтів тексту і 16 вільних місць у out. inline — щоб у DecodeAVX2 код
+// компілювався з VEX-кодуванням (перехід між SSE і AVX без vzeroupper дуже дорогий).
+static inline size_t DecodeMixedBlock(const unsigned char** pp, const unsigned char* end,
+                                      uint32_t* out, size_t count, size_t capacity) {
+    const unsigned char* p = *pp;
+    __m128i bytes = _mm_loadu_si128((const __m128i*)p);
+    __m128i leadBytes = _mm_andnot_si128(
+        _mm_cmpeq_epi8(_mm_and_si128(bytes, _mm_set1_epi8((char)0xFE)), _mm_set1_epi8((char)0xC0)),
+        _mm_cmpeq_epi8(_mm_and_si128(bytes, _mm_set1_epi8((char)0xE0)), _mm_set1_epi8((char)0xC0)));
+    unsigned lead = (unsigned)_mm_movemask_epi8(leadBytes);   // C2..DF
+    unsigned cont = (unsigned)_mm_movemask_epi8(
+        _mm_cmpeq_epi8(_mm_and_si128(bytes, _mm_set1_epi8((char)0xC0)), _mm_set1_epi8((char)0x80)));
+    unsigned high = (unsigned)_mm_movemask_epi8(bytes);
+
+    // Кожен старший байт — початок або продовження, за кожним початком іде рівно одне
+    // продовження в межах блоку (початок у позиції 15 сюди не підходить)
+    if ((lead | cont) != high || cont != (lead << 1)) {
+        count = DecodeScalar(&p, p + 16, end, out, count, capacity);
+        *pp = p;
+        return count;
+    }
+
+    // Позиція i: ASCII — сам байт, початок — ((b[i] & 0x1F) << 6) | (b[i+1] & 0x3F)
+    const __m128i zero = _mm_setzero_si128();
+    __m128i next = _mm_srli_si128(bytes, 1);
+    uint16_t values[16];
+    for (int half = 0; half < 2; half++) {
+        __m128i b = half ? _mm_unpackhi_epi8(bytes, zero) : _mm_unpacklo_epi8(bytes, zero);
+        __m128i n = half ? _mm_unpackhi_epi8(next, zero) : _mm_unpacklo_epi8(next, zero);
+        __m128i isLead = half ? _mm_unpackhi_epi8(leadBytes, leadBytes) : _mm_unpacklo_epi8(leadBytes, leadBytes);
+        __m128i two = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(b, _mm_set1_epi16(0x1F)), 6),
+                                   _mm_and_si128(n, _mm_set1_epi16(0x3F)));
+        __m128i value = _mm_or_si128(_mm_and_si128(isLead, two), _mm_andnot_si128(isLead, b));
+        _mm_storeu_si128((__m128i*)(values + half * 8), value);
+    }
+    for (unsigned keep = ~cont & 0xFFFF; keep; keep &= keep - 1) {
+        out[count++] = values[__builtin_ctz(keep)];
+    }
+    *pp = p + 16;
+    return count;
+}
+
+// SSE2: 16 ASCII байтів за крок розширюються до 16 кодових точок без розгалужень;
+// блок з не-ASCII байтами — DecodeMixedBlock
+static size_t DecodeSSE2(const unsigned char** pp, const unsigned char* end,
+                         uint32_t* out, size_t count, size_t capacity) {
+    const unsigned char* p = *pp;
+    const __m128i zero = _mm_setzero_si128();
+    while (end - p >= 16 && capacity - count >= 16) {
+        __m128i bytes = _mm_loadu_si128((const __m128i*)p);
+        if (_mm_movemask_epi8(bytes) == 0) {   // Старші біти всіх 16 байтів нульові — чистий ASCII
+            __m128i lo = _mm_unpacklo_epi8(bytes, zero);
+            __m128i hi = _mm_unpackhi_epi8(bytes, zero);
+            _mm_storeu_si128((__m128i*)(out + count), _mm_unpacklo_epi16(lo, zero));
+            _mm_storeu_si128((__m128i*)(out + count + 4), _mm_unpackhi_epi16(lo, zero));
+            _mm_storeu_si128((__m128i*)(out + count + 8), _mm_unpacklo_epi16(hi, zero));
+            _mm_storeu_si128((__m128i*)(out + count + 12), _mm_unpackhi_epi16(hi, zero));
+            p += 16;
+            count += 16;
+        } else {
+            count = DecodeMixedBlock(&p, end, out, count, capacity);
+        }
+    }
+    *pp = p;
+    return count;
+}
+#endif
+
+#ifdef UTF8_DECODER_AVX2
+// AVX2: 32 ASCII байти за крок (функція компілюється для AVX2 і викликається лише на процесорах з ним)
+__attribute__((target("avx2")))
+static size_t DecodeAVX2(const unsigned char** pp, const unsigned char* end,
+                         uint32_t* out, size_t count, size_t capacity) {
+    const unsigned char* p = *pp;
+    while (end - p >= 32 && capacity - count >= 32) {
+        __m256i bytes = _mm256_loadu_si256((const __m256i*)p);
+        if (_mm256_movemask_epi8(bytes) == 0) {
+            for (int i = 0; i < 32; i += 8) {
+                __m128i eight = _mm_loadl_epi64((const __m128i*)(p + i));
+                _mm256_storeu_si256((__m256i*)(out + count + i), _mm256_cvtepu8_epi32(eight));
+            }
+            p += 32;
+            count += 32;
+        } else {
+            count = DecodeMixedBlock(&p, end, out, count, capacity);
+        }
+    }
+    *pp = p;
+    return count;
+}
+#endif
+
+size_t Utf8Decoder_Decode(const char* text, size_t length, uint32_t* out, size_t capacity, size_t* consumed) {
+    const unsigned char* p = (const unsigned char*)text;
+    const unsigned char* end = p + length;
+    size_t count = 0;
+
+#ifdef UTF8_DECODER_AVX2
+    if (__builtin_cpu_supports("avx2")) count = DecodeAVX2(&p, end, out, count, capacity);
+#endif
+#ifdef UTF8_DECODER_SSE2
+    count = DecodeSSE2(&p, end, out, count, capacity);
+#endif
+    // Хвіст коротший за блок (або вся робота без SIMD)
+    count = DecodeScalar(&p, end, end, out, count, capacity);
+
+    if (consumed) *consumed = (size_t)(p - (const unsigned char*)text);
+    return count;
+}
+
+size_t Utf8Decoder_Count(const char* text, size_t length) {
+    const unsigned char* p = (const unsigned char*)text;
+    const unsigned char* end = p + length;
+    size_t count = 0;
+    uint32_t codepoint;
+
+    while (p < end) {
+#ifdef UTF8_DECODER_SSE2
+        // 16 ASCII байтів — 16 символів без декодування
+        if (end - p >= 16 && _mm_movemask_epi8(_mm_loadu_si128((const __m128i*)p)) == 0) {
+            p += 16;
+            count += 16;
+            continue;
+        }
+#endif
+        const unsigned char* stop = end - p > 16 ? p + 16 : end;
+        while (p < stop) {
+            if (*p < 0x80) {
+                p++;
+            } else {
+                p += DecodeSequence(p, end, &codepoint);
+            }
+            count++;
+        }
+    }
+    return count;
+}
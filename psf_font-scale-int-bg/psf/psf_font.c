@@ -6,6 +6,13 @@
 #include <stdlib.h>         // Для динамічного виділення пам’яті (malloc, free)
 #include <string.h>         // Для роботи зі строками (strncpy, strtok)
 #include "UnicodeGlyphMap.h"// Відповідність Unicode → індекс гліфа шрифту
+#include "Utf8Decoder.h"     // Пакетне декодування UTF-8 з перевіркою (SSE2/AVX2)
+#include "FontFallback.h"   // Ланцюжок запасних шрифтів (DrawPSFTextFallback)
+#include <fcntl.h>          // Для open (завантаження через mmap)
+#include <unistd.h>         // Для close
+#include <sys/mman.h>       // Для mmap/munmap
+#include <sys/stat.h>       // Для fstat (розмір файлу)
+#include <zlib.h>           // Для gzopen/gzread (стиснуті шрифти .psf.gz)
 
 // Магічні числа для ідентифікації форматів PSF1 і PSF2
 #define PSF1_MAGIC0 0x36
@@ -16,6 +23,15 @@
 #define PSF2_MAGIC2 0x4A
 #define PSF2_MAGIC3 0x86
 
+// Перші байти gzip-потоку (.psf.gz, .psfu.gz)
+#define GZIP_MAGIC0 0x1F
+#define GZIP_MAGIC1 0x8B
+
+// Прапорці наявності Unicode-таблиці
+#define PSF1_MODEHASTAB 0x02        // PSF1: після гліфів іде таблиця
+#define PSF1_MODEHASSEQ 0x04        // PSF1: таблиця з послідовностями
+#define PSF2_HAS_UNICODE_TABLE 0x01 // PSF2: flags & 1
+
 // Заголовок формату PSF1 (короткий)
 typedef struct {
     unsigned char magic[2];  // Магічні байти для ідентифікації формату
@@ -48,130 +64,1349 @@ static Color InvertColor(Color c);
 static Color GetContrastingInvertedBackground(Color textColor);
 
 
-// Функція читання 4 байтів з файлу у форматі little-endian (молодший байт перший)
-static uint32_t ReadLE32(FILE* f) {
-    uint8_t b[4];
-    fread(b, 1, 4, f);
-    return (uint32_t)b[0] | ((uint32_t)b[1] << 8) | ((uint32_t)b[2] << 16) | ((uint32_t)b[3] << 24);
+// Функція читання 4 байтів з файлу у форматі little-endian (молодший байт перший)
+static uint32_t ReadLE32(gzFile f) {
+    uint8_t b[4] = {0};
+    gzread(f, b, 4);
+    return (uint32_t)b[0] | ((uint32_t)b[1] << 8) | ((uint32_t)b[2] << 16) | ((uint32_t)b[3] << 24);
+}
+
+// Те саме читання little-endian, але з буфера в пам’яті
+static uint32_t ReadLE32Mem(const unsigned char* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// Розбір заголовку PSF1/PSF2 з буфера data розміром size.
+// Заповнює параметри шрифту, зміщення початку гліфів у *glyphOffset
+// і ознаку наявності Unicode-таблиці після гліфів у *hasUnicodeTable.
+// Повертає 1 при успіху, 0 якщо формат не підтримується або буфер обрізаний.
+static int ParsePSFHeaderMem(const unsigned char* data, size_t size, PSF_Font* font,
+                             size_t* glyphOffset, int* hasUnicodeTable) {
+    if (size >= 4 && data[0] == PSF1_MAGIC0 && data[1] == PSF1_MAGIC1) {
+        font->isPSF2 = 0;
+        font->width = 8;                       // Ширина символу в PSF1 завжди 8
+        font->height = data[3];                // Висота символу = розмір гліфа
+        font->charsize = data[3];
+        font->charcount = (data[2] & 0x01) ? 512 : 256;
+        *glyphOffset = sizeof(PSF1_Header);
+        *hasUnicodeTable = (data[2] & (PSF1_MODEHASTAB | PSF1_MODEHASSEQ)) != 0;
+    }
+    else if (size >= 32 && data[0] == PSF2_MAGIC0 && data[1] == PSF2_MAGIC1 &&
+             data[2] == PSF2_MAGIC2 && data[3] == PSF2_MAGIC3) {
+        font->isPSF2 = 1;
+        font->charcount = (int)ReadLE32Mem(data + 16);
+        font->charsize = (int)ReadLE32Mem(data + 20);
+        font->height = (int)ReadLE32Mem(data + 24);
+        font->width = (int)ReadLE32Mem(data + 28);
+        *glyphOffset = ReadLE32Mem(data + 8); // headersize
+        *hasUnicodeTable = (ReadLE32Mem(data + 12) & PSF2_HAS_UNICODE_TABLE) != 0;
+    }
+    else {
+        return 0;
+    }
+
+    // Гліф має вміщати width x height біт, а гліфи — повністю поміщатися у буфер
+    if (font->charcount <= 0 || font->charsize <= 0 || font->width <= 0 || font->height <= 0 ||
+        (size_t)font->charsize < ((size_t)font->width + 7) / 8 * (size_t)font->height ||
+        *glyphOffset > size ||
+        (size - *glyphOffset) / (size_t)font->charsize < (size_t)font->charcount) {
+        return 0;
+    }
+    return 1;
+}
+
+// Декодування одного UTF-8 символу Unicode-таблиці PSF2 з перевіркою меж буфера.
+// Повертає кількість байтів або 0, якщо послідовність некоректна.
+static int DecodeTableUTF8(const unsigned char* p, const unsigned char* end, uint32_t* out_codepoint) {
+    int len;
+    uint32_t cp;
+    if (p[0] < 0x80)                { *out_codepoint = p[0]; return 1; }
+    else if ((p[0] & 0xE0) == 0xC0) { len = 2; cp = p[0] & 0x1F; }
+    else if ((p[0] & 0xF0) == 0xE0) { len = 3; cp = p[0] & 0x0F; }
+    else if ((p[0] & 0xF8) == 0xF0) { len = 4; cp = p[0] & 0x07; }
+    else return 0;
+
+    if (end - p < len) return 0;
+    for (int i = 1; i < len; i++) {
+        if ((p[i] & 0xC0) != 0x80) return 0;
+        cp = (cp << 6) | (p[i] & 0x3F);
+    }
+    *out_codepoint = cp;
+    return len;
+}
+
+// Розбір Unicode-таблиці PSF1/PSF2, що йде одразу після гліфів.
+// Для кожного гліфа таблиця містить перелік кодових точок, які він зображує:
+//   PSF1 — 16-бітні значення, кінець запису 0xFFFF, початок послідовності 0xFFFE;
+//   PSF2 — UTF-8, кінець запису 0xFF, початок послідовності 0xFE.
+// Послідовності (комбіновані символи) пропускаються — індексуються лише окремі кодові точки.
+static UnicodeTable* ParsePSFUnicodeTableMem(const unsigned char* p, size_t size, int isPSF2, int charcount) {
+    UnicodeTable* table = (UnicodeTable*)malloc(sizeof(UnicodeTable));
+    if (!table) return NULL;
+    UnicodeTable_Init(table);
+    if (table->pageCount == 0) {
+        free(table);
+        return NULL;
+    }
+
+    const unsigned char* end = p + size;
+    int glyph = 0;
+    int inSequence = 0;
+
+    if (isPSF2) {
+        while (p < end && glyph < charcount) {
+            if (*p == 0xFF) { glyph++; inSequence = 0; p++; continue; }
+            if (*p == 0xFE) { inSequence = 1; p++; continue; }
+            uint32_t codepoint = 0;
+            int bytes = DecodeTableUTF8(p, end, &codepoint);
+            if (bytes == 0) { p++; continue; } // Пошкоджений байт пропускаємо
+            if (!inSequence) UnicodeTable_Set(table, codepoint, glyph);
+            p += bytes;
+        }
+    } else {
+        while (end - p >= 2 && glyph < charcount) {
+            uint32_t value = (uint32_t)p[0] | ((uint32_t)p[1] << 8);
+            p += 2;
+            if (value == 0xFFFF) { glyph++; inSequence = 0; continue; }
+            if (value == 0xFFFE) { inSequence = 1; continue; }
+            if (!inSequence) UnicodeTable_Set(table, value, glyph);
+        }
+    }
+    return table;
+}
+
+// Рядок гліфа у вигляді 64-бітової маски: старший біт — лівий піксель, біти за межами ширини обнулено
+static uint64_t PackGlyphRow(const unsigned char* row, int bytes_per_row, int width) {
+    uint64_t mask = 0;
+    for (int b = 0; b < bytes_per_row; b++) {
+        mask |= (uint64_t)row[b] << (56 - 8 * b);
+    }
+    return mask & (~0ULL << (64 - width));
+}
+
+// Обчислення меж «чорнила» кожного гліфа: перший/останній непорожній рядок і стовпець.
+// Растеризатори пропускають порожні рядки і порожні гліфи (пробіл) повністю.
+// При нестачі пам’яті межі не будуються і малювання йде звичайним шляхом.
+static void BuildPSFGlyphBounds(PSF_Font* font) {
+    font->glyphBounds = (PSF_GlyphBounds*)calloc(font->charcount, sizeof(PSF_GlyphBounds));
+    if (!font->glyphBounds) return;
+
+    int bytes_per_row = (font->width + 7) / 8;
+    // Маска значущих бітів останнього байта рядка (решта — вирівнювання)
+    unsigned char lastByteMask = (unsigned char)(0xFF << ((bytes_per_row * 8 - font->width) & 7));
+
+    for (int c = 0; c < font->charcount; c++) {
+        const unsigned char* glyph = font->glyphBuffer + (size_t)c * font->charsize;
+        PSF_GlyphBounds* b = &font->glyphBounds[c];
+        int firstRow = -1, lastRow = -1;
+        int firstCol = font->width, lastCol = -1;
+
+        for (int row = 0; row < font->height; row++) {
+            const unsigned char* bits = glyph + row * bytes_per_row;
+            for (int byte = 0; byte < bytes_per_row; byte++) {
+                unsigned char value = bits[byte];
+                if (byte == bytes_per_row - 1) value &= lastByteMask;
+                if (!value) continue;
+
+                int left = byte * 8 + __builtin_clz(value) - 24;       // Старший біт — лівий піксель
+                int right = byte * 8 + 7 - __builtin_ctz(value);
+                if (left < firstCol) firstCol = left;
+                if (right > lastCol) lastCol = right;
+                if (firstRow < 0) firstRow = row;
+                lastRow = row;
+            }
+        }
+
+        if (firstRow < 0) {
+            b->isEmpty = 1;
+        } else {
+            b->firstRow = (uint16_t)firstRow;
+            b->lastRow = (uint16_t)lastRow;
+            b->firstCol = (uint16_t)firstCol;
+            b->lastCol = (uint16_t)lastCol;
+        }
+    }
+}
+
+// Межі «чорнила» гліфа або NULL, якщо їх не обчислено (посторінковий шрифт)
+const PSF_GlyphBounds* GetPSFGlyphBounds(const PSF_Font* font, int index) {
+    if (!font->glyphBounds || index < 0 || index >= font->charcount) return NULL;
+    return &font->glyphBounds[index];
+}
+
+// Розклад кожного гліфа на прямокутники: горизонтальні відрізки пікселів кожного рядка,
+// причому однакові відрізки сусідніх рядків зливаються в один прямокутник.
+// Бекенди із заливкою прямокутників тоді малюють гліф кількома викликами замість одного на піксель.
+// Будується на вимогу, як і маски: завантажувачі без копіювання нічого під нього не виділяють.
+// Повертає 1 при успіху, 0 якщо ширина більша за 64, шрифт посторінковий чи стиснутий або бракує пам’яті.
+int BuildPSFGlyphRects(PSF_Font* font) {
+    if (font->glyphRects) return 1;
+    if (font->width <= 0 || font->width > 64 || !font->glyphBuffer) return 0;
+
+    int bytes_per_row = (font->width + 7) / 8;
+    size_t capacity = (size_t)font->charcount * 4, count = 0;
+    PSF_GlyphRect* rects = (PSF_GlyphRect*)malloc(capacity * sizeof(PSF_GlyphRect));
+    uint32_t* start = (uint32_t*)malloc(((size_t)font->charcount + 1) * sizeof(uint32_t));
+    if (!rects || !start) goto fail;
+
+    for (int c = 0; c < font->charcount; c++) {
+        const unsigned char* glyph = font->glyphBuffer + (size_t)c * font->charsize;
+        PSF_GlyphRect open[32], next[32]; // Відкриті прямокутники попереднього і поточного рядка
+        int openCount = 0;
+        start[c] = (uint32_t)count;
+
+        // Додатковий порожній рядок у кінці закриває всі відкриті прямокутники
+        for (int row = 0; row <= font->height; row++) {
+            uint64_t mask = row < font->height
+                            ? PackGlyphRow(glyph + row * bytes_per_row, bytes_per_row, font->width) : 0;
+            int nextCount = 0;
+
+            // Розбиваємо рядок на відрізки і продовжуємо прямокутники з тими самими x і шириною
+            while (mask) {
+                int x0 = __builtin_clzll(mask);
+                uint64_t rest = ~(mask << x0);
+                int len = rest ? __builtin_clzll(rest) : 64;
+                mask = (x0 + len >= 64) ? 0 : mask & (~0ULL >> (x0 + len));
+
+                PSF_GlyphRect r = { (uint16_t)x0, (uint16_t)row, (uint16_t)len, 1 };
+                for (int i = 0; i < openCount; i++) {
+                    if (open[i].w && open[i].x == x0 && open[i].w == len) {
+                        r = open[i];
+                        r.h++;
+                        open[i].w = 0; // Прямокутник продовжено, він не закривається
+                        break;
+                    }
+                }
+                next[nextCount++] = r;
+            }
+
+            // Прямокутники, що не продовжились у цьому рядку, готові
+            for (int i = 0; i < openCount; i++) {
+                if (!open[i].w) continue;
+                if (count == capacity) {
+                    capacity *= 2;
+                    PSF_GlyphRect* grown = (PSF_GlyphRect*)realloc(rects, capacity * sizeof(PSF_GlyphRect));
+                    if (!grown) goto fail;
+                    rects = grown;
+                }
+                rects[count++] = open[i];
+            }
+
+            memcpy(open, next, nextCount * sizeof(PSF_GlyphRect));
+            openCount = nextCount;
+        }
+    }
+    start[font->charcount] = (uint32_t)count;
+
+    font->glyphRects = rects;
+    font->glyphRectStart = start;
+    return 1;
+
+fail:
+    free(rects);
+    free(start);
+    return 0;
+}
+
+// Прямокутники гліфа (*count штук) або NULL, якщо розклад не побудовано
+const PSF_GlyphRect* GetPSFGlyphRects(const PSF_Font* font, int index, int* count) {
+    if (!font->glyphRects || index < 0 || index >= font->charcount) return NULL;
+    *count = (int)(font->glyphRectStart[index + 1] - font->glyphRectStart[index]);
+    return font->glyphRects + font->glyphRectStart[index];
+}
+
+// Номер наступного завантаженого шрифту. Номери не повторюються, тож кеш, прив’язаний до номера,
+// не сплутає новий шрифт зі звільненим навіть при повторному використанні тієї ж адреси буфера.
+// Атомарний, бо шрифти завантажуються і у фонових потоках (AsyncFontLoader).
+static uint32_t NextPSFFontSerial(void) {
+    static uint32_t lastSerial = 0;
+    return __atomic_add_fetch(&lastSerial, 1, __ATOMIC_RELAXED);
+}
+
+// Розбір цілого PSF файлу, що лежить у пам’яті: заголовок, гліфи на місці (без копіювання)
+// та Unicode-таблиця. Повертає 1 при успіху, 0 якщо формат не підтримується.
+static int ParsePSFFontMem(const unsigned char* data, size_t size, PSF_Font* font) {
+    size_t glyphOffset = 0;
+    int hasUnicodeTable = 0;
+    if (!ParsePSFHeaderMem(data, size, font, &glyphOffset, &hasUnicodeTable)) return 0;
+
+    font->glyphBuffer = (unsigned char*)data + glyphOffset;
+    if (hasUnicodeTable) {
+        size_t tableOffset = glyphOffset + (size_t)font->charcount * font->charsize;
+        font->unicodeTable = ParsePSFUnicodeTableMem(data + tableOffset, size - tableOffset,
+                                                     font->isPSF2, font->charcount);
+    }
+    BuildPSFGlyphBounds(font);
+    font->serial = NextPSFFontSerial();
+    return 1;
+}
+
+// Читання Unicode-таблиці з поточної позиції файлу (одразу після гліфів) до кінця файлу.
+// Розмір стиснутого потоку наперед невідомий, тому буфер росте блоками.
+static UnicodeTable* ReadPSFUnicodeTable(gzFile f, int isPSF2, int charcount) {
+    size_t size = 0, capacity = 16384;
+    unsigned char* data = (unsigned char*)malloc(capacity);
+    if (!data) return NULL;
+    for (;;) {
+        if (size == capacity) {
+            unsigned char* grown = (unsigned char*)realloc(data, capacity * 2);
+            if (!grown) break;
+            data = grown;
+            capacity *= 2;
+        }
+        int n = gzread(f, data + size, (unsigned)(capacity - size));
+        if (n <= 0) break;
+        size += (size_t)n;
+    }
+    if (size == 0) {
+        free(data);
+        return NULL;
+    }
+
+    UnicodeTable* table = ParsePSFUnicodeTableMem(data, size, isPSF2, charcount);
+    free(data);
+    return table;
+}
+
+// Розмір таблиці відповідності Unicode → індекс гліфа
+static int cyr_map_size = sizeof(cyr_map) / sizeof(cyr_map[0]);
+
+// Вбудована таблиця ASCII + cyr_map з прямою адресацією.
+// Будується один раз при першому пошуку замість лінійного проходу по cyr_map на кожен символ.
+static UnicodeTable builtin_table;
+static int builtin_table_ready = 0;
+
+static void BuildBuiltinUnicodeTable(void) {
+    UnicodeTable_Init(&builtin_table);
+    // Для ASCII символів індекс співпадає з кодом символу
+    for (uint32_t c = 32; c <= 126; c++) {
+        UnicodeTable_Set(&builtin_table, c, (int)c);
+    }
+    for (int i = 0; i < cyr_map_size; i++) {
+        UnicodeTable_Set(&builtin_table, cyr_map[i].unicode, cyr_map[i].glyph_index);
+    }
+    builtin_table_ready = 1;
+}
+
+// Функція пошуку індексу гліфа за Unicode кодом символу
+static int UnicodeToGlyphIndex(uint32_t codepoint) {
+    if (codepoint >= 32 && codepoint <= 126) {
+        // Для ASCII символів індекс співпадає з кодом символу
+        return (int)codepoint;
+    }
+    if (!builtin_table_ready) BuildBuiltinUnicodeTable();
+
+    // Для кирилиці — пряма адресація у вбудованій таблиці
+    int glyph_index = UnicodeTable_Get(&builtin_table, codepoint);
+
+    // Якщо символ не знайдено, повертаємо індекс пробілу (32)
+    return (glyph_index >= 0) ? glyph_index : 32;
+}
+
+// Пошук індексу гліфа з урахуванням власної Unicode-таблиці шрифту.
+// Якщо шрифт має таблицю — O(1) пошук у ній, відсутні символи замінюються пробілом шрифту.
+// Без таблиці використовується вбудована відповідність ASCII + cyr_map.
+static int FontUnicodeToGlyphIndex(const PSF_Font* font, uint32_t codepoint) {
+    if (font->unicodeTable) {
+        int glyph_index = UnicodeTable_Get(font->unicodeTable, codepoint);
+        if (glyph_index < 0 || glyph_index >= font->charcount) {
+            glyph_index = UnicodeTable_Get(font->unicodeTable, ' ');
+        }
+        return (glyph_index >= 0 && glyph_index < font->charcount) ? glyph_index : 32;
+    }
+    return UnicodeToGlyphIndex(codepoint);
+}
+
+// Індекс гліфа для кодової точки або -1, якщо шрифт його не має (без заміни пробілом):
+// за власною Unicode-таблицею шрифту або вбудованою відповідністю ASCII + cyr_map
+int FindPSFGlyph(const PSF_Font* font, uint32_t codepoint) {
+    const UnicodeTable* map = font->unicodeTable;
+    if (!map) {
+        if (!builtin_table_ready) BuildBuiltinUnicodeTable();
+        map = &builtin_table;
+    }
+    int glyph_index = UnicodeTable_Get(map, codepoint);
+    return (glyph_index >= 0 && glyph_index < font->charcount) ? glyph_index : -1;
+}
+
+// Функція завантаження PSF шрифту з файлу filename без завершення програми при помилці.
+// Файл читається через zlib: стиснуті шрифти (.psf.gz, .psfu.gz з /usr/share/consolefonts)
+// розпаковуються потоково прямо в буфер гліфів, а нестиснуті читаються як є.
+// Повертає 1 і заповнює *out при успіху, 0 — якщо файл не вдалося відкрити або розібрати.
+// Не використовує спільного стану, тому безпечна для виклику з кількох потоків.
+int TryLoadPSFFont(const char* filename, PSF_Font* out) {
+    gzFile f = gzopen(filename, "rb");
+    if (!f) {
+        printf("Не вдалося відкрити файл шрифту: %s\n", filename);
+        return 0;
+    }
+
+    unsigned char magic[4] = {0};
+    gzread(f, magic, 4);  // Читаємо перші 4 байти для визначення формату
+
+    PSF_Font font = {0};     // Ініціалізуємо структуру шрифту нулями
+
+    if (magic[0] == PSF1_MAGIC0 && magic[1] == PSF1_MAGIC1) {
+        // Якщо формат PSF1: заголовок — це ті самі 4 байти (повертатися в стиснутому потоці дорого)
+        PSF1_Header header;
+        memcpy(&header, magic, sizeof(PSF1_Header));
+
+        font.isPSF2 = 0;
+        font.width = 8;                   // Ширина символу в PSF1 завжди 8
+        font.height = header.charsize;   // Висота символу = розмір гліфа
+        font.charsize = header.charsize;
+        font.charcount = (header.mode & 0x01) ? 512 : 256; // Кількість символів
+
+        // Виділяємо пам’ять під гліфи та читаємо їх з файлу
+        font.glyphBuffer = (unsigned char*)malloc(font.charcount * font.charsize);
+        if (!font.glyphBuffer ||
+            gzread(f, font.glyphBuffer, (unsigned)(font.charcount * font.charsize)) != font.charcount * font.charsize) {
+            goto fail;
+        }
+
+        if (header.mode & (PSF1_MODEHASTAB | PSF1_MODEHASSEQ)) {
+            font.unicodeTable = ReadPSFUnicodeTable(f, 0, font.charcount);
+        }
+    }
+    else if (magic[0] == PSF2_MAGIC0 && magic[1] == PSF2_MAGIC1 &&
+             magic[2] == PSF2_MAGIC2 && magic[3] == PSF2_MAGIC3) {
+        // Якщо формат PSF2
+        PSF2_Header header;
+        header.magic[0] = magic[0];
+        header.magic[1] = magic[1];
+        header.magic[2] = magic[2];
+        header.magic[3] = magic[3];
+        header.version = ReadLE32(f);
+        header.headersize = ReadLE32(f);
+        header.flags = ReadLE32(f);
+        header.length = ReadLE32(f);
+        header.charsize = ReadLE32(f);
+        header.height = ReadLE32(f);
+        header.width = ReadLE32(f);
+
+        font.isPSF2 = 1;
+        font.width = header.width;
+        font.height = header.height;
+        font.charcount = header.length;
+        font.charsize = header.charsize;
+
+        // Відкидаємо явно некоректні заголовки до виділення пам’яті
+        // (gzread читає не більше INT_MAX байтів за виклик)
+        if (font.charcount <= 0 || font.charsize <= 0 || font.width <= 0 || font.height <= 0 ||
+            (size_t)font.charsize < (size_t)((font.width + 7) / 8) * font.height ||
+            (size_t)font.charcount * font.charsize > 0x7FFFFFFF || header.headersize < 32) {
+            goto fail;
+        }
+
+        // Переходимо до початку гліфів (після заголовку; у стиснутому потоці — пропуском уперед)
+        if (gzseek(f, header.headersize, SEEK_SET) != (z_off_t)header.headersize) goto fail;
+
+        // Виділяємо пам’ять і розпаковуємо гліфи прямо в неї
+        int glyphBytes = font.charcount * font.charsize;
+        font.glyphBuffer = (unsigned char*)malloc((size_t)glyphBytes);
+        if (!font.glyphBuffer || gzread(f, font.glyphBuffer, (unsigned)glyphBytes) != glyphBytes) {
+            goto fail;
+        }
+
+        if (header.flags & PSF2_HAS_UNICODE_TABLE) {
+            font.unicodeTable = ReadPSFUnicodeTable(f, 1, font.charcount);
+        }
+    }
+    else {
+        goto fail;
+    }
+
+    gzclose(f);
+    BuildPSFGlyphBounds(&font);
+    font.serial = NextPSFFontSerial();
+    *out = font;
+    return 1;
+
+fail:
+    // Якщо формат не підтримується або файл обрізано
+    printf("Формат шрифту не підтримується або файл пошкоджено: %s\n", filename);
+    free(font.glyphBuffer);
+    gzclose(f);
+    return 0;
+}
+
+// Функція завантаження PSF шрифту з файлу filename (завершує програму при помилці)
+PSF_Font LoadPSFFont(const char* filename) {
+    PSF_Font font;
+    if (!TryLoadPSFFont(filename, &font)) {
+        exit(1);
+    }
+    return font;
+}
+
+// Функція завантаження PSF шрифту через mmap (тільки читання).
+// Гліфи не копіюються: glyphBuffer вказує прямо у відображення файлу,
+// тому сторінки шрифту спільні для всіх процесів, що відкрили той самий файл.
+PSF_Font LoadPSFFontMapped(const char* filename) {
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        printf("Не вдалося відкрити файл шрифту: %s\n", filename);
+        exit(1);
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        printf("Не вдалося визначити розмір файлу шрифту: %s\n", filename);
+        close(fd);
+        exit(1);
+    }
+
+    size_t size = (size_t)st.st_size;
+    void* base = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd); // Дескриптор більше не потрібен, відображення лишається дійсним
+    if (base == MAP_FAILED) {
+        printf("Не вдалося відобразити файл шрифту у пам’ять: %s\n", filename);
+        exit(1);
+    }
+
+    // Стиснутий шрифт відобразити без розпакування не можна — читаємо його в купу
+    const unsigned char* bytes = (const unsigned char*)base;
+    if (size >= 2 && bytes[0] == GZIP_MAGIC0 && bytes[1] == GZIP_MAGIC1) {
+        munmap(base, size);
+        return LoadPSFFont(filename);
+    }
+
+    PSF_Font font = {0};
+    if (!ParsePSFFontMem((const unsigned char*)base, size, &font)) {
+        printf("Формат шрифту не підтримується або файл пошкоджено\n");
+        munmap(base, size);
+        exit(1);
+    }
+
+    font.storage = PSF_STORAGE_MMAP;
+    font.mapBase = base;
+    font.mapSize = size;
+    return font;
+}
+
+// Функція посторінкового завантаження PSF шрифту: з файлу читаються лише заголовок
+// і Unicode-таблиця, а гліфи — блоками по GLYPH_PAGER_PAGE_BYTES при першому зверненні.
+// Для шрифтів з десятками тисяч гліфів (CJK) у пам’яті лишаються тільки використані сторінки;
+// maxResidentPages > 0 обмежує їх кількість (найдавніше використані витісняються).
+PSF_Font LoadPSFFontPaged(const char* filename, int maxResidentPages) {
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        printf("Не вдалося відкрити файл шрифту: %s\n", filename);
+        exit(1);
+    }
+
+    struct stat st;
+    unsigned char header[32] = {0};
+    if (fstat(fd, &st) != 0 || pread(fd, header, sizeof(header), 0) < 4) {
+        printf("Не вдалося прочитати заголовок шрифту: %s\n", filename);
+        close(fd);
+        exit(1);
+    }
+
+    // Стиснутий шрифт не читається сторінками з довільного місця — розпаковуємо цілим
+    if (header[0] == GZIP_MAGIC0 && header[1] == GZIP_MAGIC1) {
+        close(fd);
+        return LoadPSFFont(filename);
+    }
+
+    // Для перевірки меж передаємо розмір файлу: заголовок займає не більше 32 байтів
+    PSF_Font font = {0};
+    size_t fileSize = (size_t)st.st_size;
+    size_t glyphOffset = 0;
+    int hasUnicodeTable = 0;
+    if (!ParsePSFHeaderMem(header, fileSize, &font, &glyphOffset, &hasUnicodeTable)) {
+        printf("Формат шрифту не підтримується або файл пошкоджено\n");
+        close(fd);
+        exit(1);
+    }
+
+    size_t tableOffset = glyphOffset + (size_t)font.charcount * font.charsize;
+    if (hasUnicodeTable && tableOffset < fileSize) {
+        size_t tableSize = fileSize - tableOffset;
+        unsigned char* table = (unsigned char*)malloc(tableSize);
+        if (table && pread(fd, table, tableSize, (off_t)tableOffset) == (ssize_t)tableSize) {
+            font.unicodeTable = ParsePSFUnicodeTableMem(table, tableSize, font.isPSF2, font.charcount);
+        }
+        free(table);
+    }
+
+    // Пейджер стає власником дескриптора файлу
+    font.pager = GlyphPager_Create(fd, (off_t)glyphOffset, font.charcount, font.charsize, maxResidentPages);
+    if (!font.pager) {
+        printf("Не вдалося створити таблицю сторінок шрифту: %s\n", filename);
+        close(fd);
+        exit(1);
+    }
+    font.storage = PSF_STORAGE_PAGED;
+    font.serial = NextPSFFontSerial();
+    return font;
+}
+
+// Дані гліфа з індексом index незалежно від способу завантаження шрифту
+const unsigned char* GetPSFGlyph(const PSF_Font* font, int index) {
+    if (index < 0 || index >= font->charcount) return NULL;
+    if (font->pager) return GlyphPager_GetGlyph(font->pager, index);
+    if (font->compressor) return GlyphCompressor_GetGlyph(font->compressor, index);
+    return font->glyphBuffer + (size_t)index * font->charsize;
+}
+
+// Функція завантаження PSF шрифту з буфера в пам’яті (наприклад, вбудованого у програму).
+// Розбір виконується на місці: glyphBuffer вказує прямо в data, тому буфер
+// має існувати весь час життя шрифту. Окремо виділяється лише індекс Unicode-таблиці.
+// Повертає 1 при успіху, 0 якщо буфер не містить коректного PSF шрифту.
+int TryLoadPSFFontFromMemory(const void* data, size_t size, PSF_Font* out) {
+    PSF_Font font = {0};
+    if (!data || !ParsePSFFontMem((const unsigned char*)data, size, &font)) {
+        printf("Формат шрифту не підтримується або буфер пошкоджено\n");
+        return 0;
+    }
+
+    font.storage = PSF_STORAGE_MEMORY;
+    *out = font;
+    return 1;
+}
+
+// Те саме, але завершує програму при помилці
+PSF_Font LoadPSFFontFromMemory(const void* data, size_t size) {
+    PSF_Font font;
+    if (!TryLoadPSFFontFromMemory(data, size, &font)) {
+        exit(1);
+    }
+    return font;
+}
+
+// Перекодування гліфів у рядкові маски uint64_t (вирівнювання і крок гліфа — 64 байти),
+// щоб растеризатори обходили лише встановлені пікселі замість перевірки кожного біта.
+// Повертає 1 при успіху, 0 якщо ширина більша за 64, шрифт посторінковий чи стиснутий або бракує пам’яті.
+int BuildPSFRowMasks(PSF_Font* font) {
+    if (font->rowMasks) return 1;
+    if (font->width <= 0 || font->width > 64 || !font->glyphBuffer) return 0;
+
+    int bytes_per_row = (font->width + 7) / 8;
+    int stride = (font->height + 7) & ~7;   // Рядків на гліф, кратно 8 (64 байти)
+    size_t bytes = (size_t)font->charcount * stride * sizeof(uint64_t);
+    uint64_t* masks = (uint64_t*)aligned_alloc(64, bytes);
+    if (!masks) return 0;
+    memset(masks, 0, bytes);
+
+    for (int c = 0; c < font->charcount; c++) {
+        const unsigned char* glyph = font->glyphBuffer + (size_t)c * font->charsize;
+        uint64_t* rows = masks + (size_t)c * stride;
+        for (int row = 0; row < font->height; row++) {
+            rows[row] = PackGlyphRow(glyph + row * bytes_per_row, bytes_per_row, font->width);
+        }
+    }
+
+    font->rowMasks = masks;
+    font->rowStride = stride;
+    return 1;
+}
+
+// Рядкові маски гліфа або NULL, якщо їх не побудовано (див. BuildPSFRowMasks)
+const uint64_t* GetPSFGlyphRows(const PSF_Font* font, int index) {
+    if (!font->rowMasks || index < 0 || index >= font->charcount) return NULL;
+    return font->rowMasks + (size_t)index * font->rowStride;
+}
+
+// Функція звільнення пам’яті, виділеної під гліфи шрифту
+// (або зняття відображення, якщо шрифт завантажено через mmap, чи звільнення сторінок
+// посторінкового шрифту;
+// зовнішній буфер LoadPSFFontFromMemory не звільняється)
+// Похідні копії шрифту: повернуті (GetPSFRotatedFont) і стилізовані (GetPSFStyledFont).
+// Кожна копія — окремий PSF_Font, щоб вказівник на неї не змінювався при збільшенні масиву.
+typedef struct {
+    uint32_t serial;         // serial вихідного шрифту
+    int variant;             // Кут повороту або PSF_DERIVED_STYLE | стиль
+    PSF_Font* font;
+} PSF_DerivedFont;
+
+// Ознака стилізованої копії в PSF_DerivedFont.variant (кути повороту менші)
+#define PSF_DERIVED_STYLE 0x10000
+
+static PSF_DerivedFont* g_derivedFonts = NULL;
+static int g_derivedFontCount = 0;
+static int g_derivedFontCapacity = 0;
+
+// Приводить кут до 0/90/180/270, -1 — кут не кратний 90
+static int NormalizePSFRotation(int rotation) {
+    rotation %= 360;
+    if (rotation < 0) rotation += 360;
+    return (rotation % 90 == 0) ? rotation : -1;
+}
+
+// Звільняє похідні копії шрифту з номером serial
+static void FreePSFDerivedFonts(uint32_t serial) {
+    for (int i = 0; i < g_derivedFontCount; ) {
+        if (g_derivedFonts[i].serial != serial) {
+            i++;
+            continue;
+        }
+        PSF_Font* derived = g_derivedFonts[i].font;
+        g_derivedFonts[i] = g_derivedFonts[--g_derivedFontCount];
+        UnloadPSFFont(*derived);  // Обробники звільняють і кеші, побудовані для копії
+        free(derived);
+    }
+}
+
+// Похідна копія з кешу або NULL
+static const PSF_Font* FindPSFDerivedFont(uint32_t serial, int variant) {
+    for (int i = 0; i < g_derivedFontCount; i++) {
+        if (g_derivedFonts[i].serial == serial && g_derivedFonts[i].variant == variant) {
+            return g_derivedFonts[i].font;
+        }
+    }
+    return NULL;
+}
+
+// Додає побудовану копію до кешу (при нестачі пам’яті копія звільняється, повертається NULL)
+static const PSF_Font* AddPSFDerivedFont(uint32_t serial, int variant, PSF_Font* derived) {
+    if (!derived) return NULL;
+    if (g_derivedFontCount == g_derivedFontCapacity) {
+        int capacity = g_derivedFontCapacity ? g_derivedFontCapacity * 2 : 8;
+        PSF_DerivedFont* fonts = (PSF_DerivedFont*)realloc(g_derivedFonts, capacity * sizeof(PSF_DerivedFont));
+        if (!fonts) {
+            UnloadPSFFont(*derived);
+            free(derived);
+            return NULL;
+        }
+        g_derivedFonts = fonts;
+        g_derivedFontCapacity = capacity;
+    }
+    g_derivedFonts[g_derivedFontCount].serial = serial;
+    g_derivedFonts[g_derivedFontCount].variant = variant;
+    g_derivedFonts[g_derivedFontCount].font = derived;
+    g_derivedFontCount++;
+    return derived;
+}
+
+// Порожня похідна копія з гліфами width x height (буфер обнулено)
+static PSF_Font* CreatePSFDerivedFont(const PSF_Font* font, int width, int height) {
+    PSF_Font* derived = (PSF_Font*)calloc(1, sizeof(PSF_Font));
+    if (!derived) return NULL;
+
+    derived->isPSF2 = font->isPSF2;
+    derived->width = width;
+    derived->height = height;
+    derived->charcount = font->charcount;
+    derived->charsize = ((width + 7) / 8) * height;
+    derived->glyphBuffer = (unsigned char*)calloc((size_t)derived->charcount, derived->charsize);
+    if (!derived->glyphBuffer) {
+        free(derived);
+        return NULL;
+    }
+    derived->storage = PSF_STORAGE_HEAP;
+    return derived;
+}
+
+// Завершення похідної копії: ті самі допоміжні структури, що й у вихідного шрифту
+static void FinishPSFDerivedFont(const PSF_Font* font, PSF_Font* derived) {
+    BuildPSFGlyphBounds(derived);
+    if (font->glyphRects) BuildPSFGlyphRects(derived);
+    if (font->rowMasks) BuildPSFRowMasks(derived);
+    derived->serial = NextPSFFontSerial();
+}
+
+// Будує копію шрифту, повернуту на rotation градусів проти годинникової стрілки:
+// стовпці гліфа стають рядками, тож копія малюється тими ж рядковими шляхами
+// (межі, прямокутники, маски), що й звичайний текст
+static PSF_Font* BuildPSFRotatedFont(const PSF_Font* font, int rotation) {
+    int quarter = (rotation == 90 || rotation == 270);
+    PSF_Font* rotated = CreatePSFDerivedFont(font, quarter ? font->height : font->width,
+                                             quarter ? font->width : font->height);
+    if (!rotated) return NULL;
+
+    int w = font->width, h = font->height;
+    int srcRowBytes = (w + 7) / 8;
+    int dstRowBytes = (rotated->width + 7) / 8;
+    for (int c = 0; c < font->charcount; c++) {
+        const unsigned char* src = GetPSFGlyph(font, c);
+        if (!src) continue;  // Сторінку не прочитано — гліф копії лишається порожнім
+        unsigned char* dst = rotated->glyphBuffer + (size_t)c * rotated->charsize;
+        for (int row = 0; row < h; row++) {
+            for (int col = 0; col < w; col++) {
+                if (!(src[row * srcRowBytes + col / 8] & (0x80 >> (col % 8)))) continue;
+                int dx, dy;
+                switch (rotation) {
+                    case 90:  dx = row;         dy = w - 1 - col; break;
+                    case 180: dx = w - 1 - col; dy = h - 1 - row; break;
+                    default:  dx = h - 1 - row; dy = col;         break;  // 270
+                }
+                dst[dy * dstRowBytes + dx / 8] |= (unsigned char)(0x80 >> (dx % 8));
+            }
+        }
+    }
+
+    FinishPSFDerivedFont(font, rotated);
+    return rotated;
+}
+
+// Повернута копія шрифту, що будується при першому зверненні і живе до звільнення шрифту.
+// rotation = 0 повертає сам font, NULL — кут не кратний 90 або бракує пам’яті.
+const PSF_Font* GetPSFRotatedFont(const PSF_Font* font, int rotation) {
+    rotation = NormalizePSFRotation(rotation);
+    if (rotation < 0) return NULL;
+    if (rotation == 0) return font;
+
+    const PSF_Font* rotated = FindPSFDerivedFont(font->serial, rotation);
+    if (rotated) return rotated;
+    return AddPSFDerivedFont(font->serial, rotation, BuildPSFRotatedFont(font, rotation));
+}
+
+// Нахил курсиву: верхній рядок зсувається вправо на (height - 1) / 4 пікселів
+static int PSFItalicSlant(int height) {
+    return (height - 1) / 4;
+}
+
+// Відступ гліфа стилю від лівого верхнього кута комірки вихідного шрифту (обведення виходить на 1 піксель)
+int GetPSFStylePadding(int style) {
+    return (style & PSF_STYLE_OUTLINE) ? 1 : 0;
+}
+
+// Будує стилізовану копію шрифту. Кожен рядок гліфа — одне слово uint64_t (старший біт — лівий піксель),
+// тож стилі обчислюються порозрядними операціями над цілими рядками:
+//   жирний  — row | (row >> 1);
+//   курсив  — зсув рядка вправо пропорційно висоті над нижнім рядком;
+//   обведення — розширення на 1 піксель у всі боки (OR сусідніх рядків і зсувів) XOR вихідний гліф;
+//   тінь    — гліф, зсунутий на 1 піксель вправо-вниз, без пікселів самого гліфа.
+// Із обведенням або тінню копія містить лише оздоблення (малюється під основним текстом).
+static PSF_Font* BuildPSFStyledFont(const PSF_Font* font, int style) {
+    int w = font->width, h = font->height;
+    int bold = (style & PSF_STYLE_BOLD) ? 1 : 0;
+    int slant = (style & PSF_STYLE_ITALIC) ? PSFItalicSlant(h) : 0;
+    int outline = (style & PSF_STYLE_OUTLINE) ? 1 : 0;
+    int shadow = (style & PSF_STYLE_SHADOW) ? 1 : 0;
+    int pad = outline;
+
+    int width = pad + w + bold + slant + outline + shadow;
+    int height = pad + h + outline + shadow;
+    if (width > 64) return NULL;
+
+    PSF_Font* styled = CreatePSFDerivedFont(font, width, height);
+    uint64_t* body = (uint64_t*)calloc((size_t)height, sizeof(uint64_t));
+    uint64_t* decor = (uint64_t*)calloc((size_t)height, sizeof(uint64_t));
+    if (!styled || !body || !decor) {
+        if (styled) {
+            free(styled->glyphBuffer);
+            free(styled);
+        }
+        free(body);
+        free(decor);
+        return NULL;
+    }
+
+    int srcRowBytes = (w + 7) / 8;
+    int dstRowBytes = (width + 7) / 8;
+    for (int c = 0; c < font->charcount; c++) {
+        const unsigned char* src = GetPSFGlyph(font, c);
+        if (!src) continue;  // Сторінку не прочитано — гліф копії лишається порожнім
+        memset(body, 0, (size_t)height * sizeof(uint64_t));
+
+        // Основний гліф: рядок у слово, зсунутий на відступ і нахил курсиву
+        for (int row = 0; row < h; row++) {
+            uint64_t mask = PackGlyphRow(src + row * srcRowBytes, srcRowBytes, w) >> pad;
+            if (bold) mask |= mask >> 1;
+            if (slant) mask >>= (h - 1 - row) / 4;
+            body[pad + row] = mask;
+        }
+
+        const uint64_t* rows = body;
+        if (outline || shadow) {
+            for (int row = 0; row < height; row++) {
+                uint64_t ring = 0, drop = 0;
+                if (outline) {
+                    // Розширення: рядок з сусідами по горизонталі, потім OR з рядками вище і нижче
+                    for (int r = row - 1; r <= row + 1; r++) {
+                        if (r < 0 || r >= height) continue;
+                        ring |= body[r] | (body[r] << 1) | (body[r] >> 1);
+                    }
+                }
+                if (shadow && row > 0) {
+                    uint64_t above = body[row - 1];
+                    if (outline) {
+                        // Тінь відкидає обведений гліф
+                        for (int r = row - 2; r <= row; r++) {
+                            if (r < 0) continue;
+                            above |= body[r] | (body[r] << 1) | (body[r] >> 1);
+                        }
+                    }
+                    drop = above >> 1;
+                }
+                decor[row] = (ring | drop) & ~body[row];
+            }
+            rows = decor;
+        }
+
+        unsigned char* dst = styled->glyphBuffer + (size_t)c * styled->charsize;
+        for (int row = 0; row < height; row++) {
+            for (int b = 0; b < dstRowBytes; b++) {
+                dst[row * dstRowBytes + b] = (unsigned char)(rows[row] >> (56 - 8 * b));
+            }
+        }
+    }
+    free(body);
+    free(decor);
+
+    FinishPSFDerivedFont(font, styled);
+    return styled;
+}
+
+// Стилізована копія шрифту (комбінація PSF_STYLE_*), будується один раз при першому зверненні
+// і живе до звільнення шрифту. PSF_STYLE_REGULAR повертає сам font, NULL — гліф стилю ширший
+// за 64 пікселі або бракує пам’яті.
+const PSF_Font* GetPSFStyledFont(const PSF_Font* font, int style) {
+    style &= PSF_STYLE_BOLD | PSF_STYLE_ITALIC | PSF_STYLE_OUTLINE | PSF_STYLE_SHADOW;
+    if (style == PSF_STYLE_REGULAR) return font;
+
+    const PSF_Font* styled = FindPSFDerivedFont(font->serial, PSF_DERIVED_STYLE | style);
+    if (styled) return styled;
+    return AddPSFDerivedFont(font->serial, PSF_DERIVED_STYLE | style, BuildPSFStyledFont(font, style));
+}
+
+// Обробники звільнення шрифтів і зміни гліфів (кеші, що залежать від шрифту)
+#define MAX_PSF_HOOKS 8
+static PSF_UnloadHook g_unloadHooks[MAX_PSF_HOOKS];
+static int g_unloadHookCount = 0;
+static PSF_GlyphChangedHook g_glyphChangedHooks[MAX_PSF_HOOKS];
+static int g_glyphChangedHookCount = 0;
+
+// Кеш розкладених рядків (GetPSFTextRun, поруч з PreparePSFText)
+static void ForgetPSFTextRuns(uint32_t serial);
+static void DrawPSFTextRun(const PSF_Font* font, const PSF_PreparedText* text, int x, int y, Color color);
+
+int AddPSFUnloadHook(PSF_UnloadHook hook) {
+    for (int i = 0; i < g_unloadHookCount; i++) {
+        if (g_unloadHooks[i] == hook) return 1;
+    }
+    if (!hook || g_unloadHookCount >= MAX_PSF_HOOKS) return 0;
+    g_unloadHooks[g_unloadHookCount++] = hook;
+    return 1;
+}
+
+int AddPSFGlyphChangedHook(PSF_GlyphChangedHook hook) {
+    for (int i = 0; i < g_glyphChangedHookCount; i++) {
+        if (g_glyphChangedHooks[i] == hook) return 1;
+    }
+    if (!hook || g_glyphChangedHookCount >= MAX_PSF_HOOKS) return 0;
+    g_glyphChangedHooks[g_glyphChangedHookCount++] = hook;
+    return 1;
+}
+
+// Звільнення пам’яті шрифту без виклику обробників
+static void FreePSFFontData(PSF_Font font) {
+    free(font.rowMasks);
+    free(font.glyphBounds);
+    free(font.glyphRects);
+    free(font.glyphRectStart);
+    if (font.unicodeTable) {
+        UnicodeTable_Free(font.unicodeTable);
+        free(font.unicodeTable);
+    }
+    switch (font.storage) {
+        case PSF_STORAGE_HEAP:   free(font.glyphBuffer); break;
+        case PSF_STORAGE_MMAP:   munmap(font.mapBase, font.mapSize); break;
+        case PSF_STORAGE_MEMORY: break;
+        case PSF_STORAGE_PAGED:  GlyphPager_Free(font.pager); break;
+        case PSF_STORAGE_COMPRESSED: GlyphCompressor_Free(font.compressor); break;
+    }
+}
+
+void UnloadPSFFont(PSF_Font font) {
+    FreePSFDerivedFonts(font.serial);
+    ForgetPSFTextRuns(font.serial);
+    // Спершу залежні кеші: обробник ще бачить дані шрифту
+    for (int i = 0; i < g_unloadHookCount; i++) {
+        g_unloadHooks[i](&font);
+    }
+    FreePSFFontData(font);
+}
+
+// Заміна даних шрифту на місці новою версією того самого файлу.
+// Якщо розміри гліфів і їх кількість не змінилися, шрифт зберігає serial, тож кеші лишаються,
+// а обробники AddPSFGlyphChangedHook отримують лише гліфи, чиї біти справді змінилися.
+// Інакше старий шрифт звільняється повністю (UnloadPSFFont) і кеші будуються заново.
+int ReloadPSFFontInPlace(PSF_Font* font, PSF_Font newFont) {
+    if (newFont.width != font->width || newFont.height != font->height ||
+        newFont.charcount != font->charcount || newFont.charsize != font->charsize) {
+        UnloadPSFFont(*font);
+        *font = newFont;
+        return newFont.charcount;
+    }
+
+    // Порівняння гліфів до заміни: тут ще доступні обидві версії
+    unsigned char* changed = (unsigned char*)calloc((size_t)font->charcount, 1);
+    int changedCount = 0;
+    for (int i = 0; i < font->charcount; i++) {
+        const unsigned char* oldGlyph = GetPSFGlyph(font, i);
+        const unsigned char* newGlyph = GetPSFGlyph(&newFont, i);
+        if (!changed || !oldGlyph || !newGlyph || memcmp(oldGlyph, newGlyph, font->charsize) != 0) {
+            if (changed) changed[i] = 1;
+            changedCount++;
+        }
+    }
+
+    // Прямокутники й маски будувалися на вимогу — будуємо їх і для нової версії
+    if (font->glyphRects) BuildPSFGlyphRects(&newFont);
+    if (font->rowMasks) BuildPSFRowMasks(&newFont);
+
+    // Похідні копії (повернуті, стилізовані) будуються заново при наступному зверненні
+    FreePSFDerivedFonts(font->serial);
+    // Розкладки рядків залежать від Unicode-таблиці й порожніх гліфів нової версії
+    ForgetPSFTextRuns(font->serial);
+
+    PSF_Font oldFont = *font;
+    newFont.serial = oldFont.serial;
+    *font = newFont;
+    FreePSFFontData(oldFont);
+
+    for (int i = 0; i < font->charcount; i++) {
+        if (changed && !changed[i]) continue;
+        for (int h = 0; h < g_glyphChangedHookCount; h++) {
+            g_glyphChangedHooks[h](font, i);
+        }
+    }
+    free(changed);
+    return changedCount;
+}
+
+// Ранг частоти кодової точки для порядку гліфів у компактному шрифті (менший — частіший)
+static int CompactGlyphRank(uint32_t cp) {
+    if (cp == ' ') return 0;
+    if (cp >= '0' && cp <= '9') return 1;
+    if (cp >= 'a' && cp <= 'z') return 2;
+    if (cp >= 'A' && cp <= 'Z') return 3;
+    if (cp > ' ' && cp <= '~') return 4;
+    if (cp >= 0x0400 && cp <= 0x04FF) return 5;  // Кирилиця
+    return 6;
+}
+
+// Пара «кодова точка → старий індекс гліфа» для побудови компактного шрифту
+typedef struct {
+    uint32_t codepoint;
+    int glyph;
+} CompactGlyphRef;
+
+static int CompareCompactGlyphRefs(const void* a, const void* b) {
+    const CompactGlyphRef* x = (const CompactGlyphRef*)a;
+    const CompactGlyphRef* y = (const CompactGlyphRef*)b;
+    int rx = CompactGlyphRank(x->codepoint), ry = CompactGlyphRank(y->codepoint);
+    if (rx != ry) return rx - ry;
+    return (x->codepoint > y->codepoint) - (x->codepoint < y->codepoint);
+}
+
+// Залишає у шрифті лише гліфи, досяжні з активної Unicode-відповідності (таблиця шрифту
+// або вбудована ASCII + cyr_map), і складає їх щільно: пробіл, цифри, латиниця, решта ASCII,
+// кирилиця, інше. Якщо задано keep — лише гліфи цих кодових точок (решта малюється пробілом).
+// Unicode-таблиця перебудовується під нові індекси, тому після стискання гліфи адресуються
+// лише через кодові точки (DrawPSFText), а не старими індексами. Шрифт отримує новий serial.
+// Повертає 1 при успіху, 0 для посторінкового шрифту або без пам’яті.
+int CompactPSFFont(PSF_Font* font, const uint32_t* keep, int keepCount) {
+    if (!font->glyphBuffer) return 0;
+
+    const UnicodeTable* map = font->unicodeTable;
+    if (!map) {
+        if (!builtin_table_ready) BuildBuiltinUnicodeTable();
+        map = &builtin_table;
+    }
+
+    // Збираємо досяжні пари з таблиці або зі списку keep
+    size_t refCapacity = keep ? (size_t)keepCount : 1024, refCount = 0;
+    CompactGlyphRef* refs = (CompactGlyphRef*)malloc((refCapacity + 1) * sizeof(CompactGlyphRef));
+    if (!refs) return 0;
+    if (keep) {
+        for (int i = 0; i < keepCount; i++) {
+            int glyph = UnicodeTable_Get(map, keep[i]);
+            if (glyph < 0 || glyph >= font->charcount) continue;
+            refs[refCount].codepoint = keep[i];
+            refs[refCount++].glyph = glyph;
+        }
+    } else {
+        for (uint32_t page = 0; page < UNICODE_TABLE_PAGES; page++) {
+            uint16_t pageNumber = map->pageIndex[page];
+            if (pageNumber == 0) continue;
+            for (uint32_t cell = 0; cell < 256; cell++) {
+                uint16_t glyph = map->pages[pageNumber][cell];
+                if (glyph == UNICODE_TABLE_NONE || glyph >= font->charcount) continue;
+                if (refCount == refCapacity) {
+                    CompactGlyphRef* grown = (CompactGlyphRef*)realloc(refs, (refCapacity * 2 + 1) * sizeof(CompactGlyphRef));
+                    if (!grown) { free(refs); return 0; }
+                    refs = grown;
+                    refCapacity *= 2;
+                }
+                refs[refCount].codepoint = (page << 8) | cell;
+                refs[refCount++].glyph = glyph;
+            }
+        }
+    }
+
+    // Пробіл — запасний гліф FontUnicodeToGlyphIndex; без нього в таблиці береться гліф 32
+    int spaceGlyph = UnicodeTable_Get(map, ' ');
+    if (spaceGlyph < 0 || spaceGlyph >= font->charcount) spaceGlyph = (font->charcount > 32) ? 32 : 0;
+    refs[refCount].codepoint = ' ';
+    refs[refCount++].glyph = spaceGlyph;
+    qsort(refs, refCount, sizeof(CompactGlyphRef), CompareCompactGlyphRefs);
+
+    int* oldToNew = (int*)malloc((size_t)font->charcount * sizeof(int));
+    int* newToOld = (int*)malloc((size_t)font->charcount * sizeof(int));
+    UnicodeTable* table = (UnicodeTable*)malloc(sizeof(UnicodeTable));
+    if (!oldToNew || !newToOld || !table) {
+        free(refs);
+        free(oldToNew);
+        free(newToOld);
+        free(table);
+        return 0;
+    }
+    for (int i = 0; i < font->charcount; i++) oldToNew[i] = -1;
+    UnicodeTable_Init(table);
+
+    // Нові індекси — у порядку першої появи гліфа серед відсортованих пар
+    int newCount = 0;
+    for (size_t i = 0; i < refCount; i++) {
+        int glyph = refs[i].glyph;
+        if (oldToNew[glyph] < 0) {
+            oldToNew[glyph] = newCount;
+            newToOld[newCount++] = glyph;
+        }
+        UnicodeTable_Set(table, refs[i].codepoint, oldToNew[glyph]);
+    }
+    free(refs);
+
+    PSF_Font compact = *font;
+    compact.charcount = newCount;
+    compact.glyphBuffer = (unsigned char*)malloc((size_t)newCount * font->charsize);
+    if (!compact.glyphBuffer) {
+        free(oldToNew);
+        free(newToOld);
+        UnicodeTable_Free(table);
+        free(table);
+        return 0;
+    }
+    for (int i = 0; i < newCount; i++) {
+        memcpy(compact.glyphBuffer + (size_t)i * font->charsize,
+               font->glyphBuffer + (size_t)newToOld[i] * font->charsize, font->charsize);
+    }
+    free(oldToNew);
+    free(newToOld);
+
+    compact.storage = PSF_STORAGE_HEAP;
+    compact.mapBase = NULL;
+    compact.mapSize = 0;
+    compact.unicodeTable = table;
+    compact.rowMasks = NULL;
+    compact.rowStride = 0;
+    compact.glyphBounds = NULL;
+    compact.glyphRects = NULL;
+    compact.glyphRectStart = NULL;
+    BuildPSFGlyphBounds(&compact);
+    if (font->glyphRects) BuildPSFGlyphRects(&compact);
+    if (font->rowMasks) BuildPSFRowMasks(&compact);
+    compact.serial = NextPSFFontSerial();
+
+    // Старі індекси гліфів більше не дійсні — кеші старої версії звільняються
+    UnloadPSFFont(*font);
+    *font = compact;
+    return 1;
+}
+
+// Завантаження з файлу зі стиснутим набором гліфів: лише символи інтерфейсу — ASCII і cyr_map
+PSF_Font LoadPSFFontCompact(const char* filename) {
+    PSF_Font font = LoadPSFFont(filename);
+
+    uint32_t keep[95 + sizeof(cyr_map) / sizeof(cyr_map[0])];
+    int keepCount = 0;
+    for (uint32_t c = 32; c <= 126; c++) keep[keepCount++] = c;
+    for (int i = 0; i < cyr_map_size; i++) keep[keepCount++] = cyr_map[i].unicode;
+
+    if (!CompactPSFFont(&font, keep, keepCount)) {
+        printf("Не вдалося стиснути набір гліфів шрифту: %s\n", filename);
+        exit(1);
+    }
+    return font;
+}
+
+// Запис 4 байтів у файл у форматі little-endian
+static void WriteLE32(FILE* f, uint32_t value) {
+    uint8_t b[4] = { (uint8_t)value, (uint8_t)(value >> 8), (uint8_t)(value >> 16), (uint8_t)(value >> 24) };
+    fwrite(b, 1, 4, f);
 }
 
-// Функція декодування одного UTF-8 символу з рядка str
-// Записує Unicode код символу у out_codepoint
-// Повертає кількість байтів, які зайняв символ у UTF-8
-static int utf8_decode(const char* str, uint32_t* out_codepoint) {
-    unsigned char c = (unsigned char)str[0];
-    if (c < 0x80) {
-        // Однобайтовий ASCII символ
-        *out_codepoint = c;
+// Кодування кодової точки в UTF-8 (для Unicode-таблиці PSF2); повертає кількість байтів
+static int EncodeUTF8(uint32_t codepoint, unsigned char* out) {
+    if (codepoint < 0x80) {
+        out[0] = (unsigned char)codepoint;
         return 1;
-    } else if ((c & 0xE0) == 0xC0) {
-        // Два байти UTF-8
-        *out_codepoint = ((str[0] & 0x1F) << 6) | (str[1] & 0x3F);
+    }
+    if (codepoint < 0x800) {
+        out[0] = (unsigned char)(0xC0 | (codepoint >> 6));
+        out[1] = (unsigned char)(0x80 | (codepoint & 0x3F));
         return 2;
-    } else if ((c & 0xF0) == 0xE0) {
-        // Три байти UTF-8
-        *out_codepoint = ((str[0] & 0x0F) << 12) | ((str[1] & 0x3F) << 6) | (str[2] & 0x3F);
+    }
+    if (codepoint < 0x10000) {
+        out[0] = (unsigned char)(0xE0 | (codepoint >> 12));
+        out[1] = (unsigned char)(0x80 | ((codepoint >> 6) & 0x3F));
+        out[2] = (unsigned char)(0x80 | (codepoint & 0x3F));
         return 3;
-    } else if ((c & 0xF8) == 0xF0) {
-        // Чотири байти UTF-8
-        *out_codepoint = ((str[0] & 0x07) << 18) | ((str[1] & 0x3F) << 12) | ((str[2] & 0x3F) << 6) | (str[3] & 0x3F);
-        return 4;
     }
-    // Невідомий або некоректний символ — повертаємо 0
-    *out_codepoint = 0;
-    return 1;
+    out[0] = (unsigned char)(0xF0 | (codepoint >> 18));
+    out[1] = (unsigned char)(0x80 | ((codepoint >> 12) & 0x3F));
+    out[2] = (unsigned char)(0x80 | ((codepoint >> 6) & 0x3F));
+    out[3] = (unsigned char)(0x80 | (codepoint & 0x3F));
+    return 4;
 }
 
-// Розмір таблиці відповідності Unicode → індекс гліфа
-static int cyr_map_size = sizeof(cyr_map) / sizeof(cyr_map[0]);
+// Порядок запису Unicode-таблиці: за гліфом, у межах гліфа — за кодовою точкою
+static int CompareGlyphRefsByGlyph(const void* a, const void* b) {
+    const CompactGlyphRef* x = (const CompactGlyphRef*)a;
+    const CompactGlyphRef* y = (const CompactGlyphRef*)b;
+    if (x->glyph != y->glyph) return x->glyph - y->glyph;
+    return (x->codepoint > y->codepoint) - (x->codepoint < y->codepoint);
+}
 
-// Функція пошуку індексу гліфа за Unicode кодом символу
-static int UnicodeToGlyphIndex(uint32_t codepoint) {
-    if (codepoint >= 32 && codepoint <= 126) {
-        // Для ASCII символів індекс співпадає з кодом символу
-        return (int)codepoint;
+// Запис шрифту у файл PSF2 з Unicode-таблицею активної відповідності (власна таблиця шрифту
+// або вбудована ASCII + cyr_map для PSF1 без таблиці), тож текст малюється так само.
+// Гліфи беруться через GetPSFGlyph, тому підходить шрифт з будь-яким способом зберігання.
+// Повертає 1 при успіху, 0 при помилці запису.
+int SavePSFFont(const PSF_Font* font, const char* filename) {
+    const UnicodeTable* map = font->unicodeTable;
+    if (!map) {
+        if (!builtin_table_ready) BuildBuiltinUnicodeTable();
+        map = &builtin_table;
     }
-    // Для кирилиці шукаємо у таблиці відповідності
-    for (int i = 0; i < cyr_map_size; i++) {
-        if (cyr_map[i].unicode == codepoint)
-            return cyr_map[i].glyph_index;
+
+    // Пари «кодова точка → гліф» з таблиці, впорядковані за гліфом
+    size_t refCount = 0, refCapacity = 1024;
+    CompactGlyphRef* refs = (CompactGlyphRef*)malloc(refCapacity * sizeof(CompactGlyphRef));
+    if (!refs) return 0;
+    for (uint32_t page = 0; page < UNICODE_TABLE_PAGES; page++) {
+        uint16_t pageNumber = map->pageIndex[page];
+        if (pageNumber == 0) continue;
+        for (uint32_t cell = 0; cell < 256; cell++) {
+            uint16_t glyph = map->pages[pageNumber][cell];
+            if (glyph == UNICODE_TABLE_NONE || glyph >= font->charcount) continue;
+            if (refCount == refCapacity) {
+                CompactGlyphRef* grown = (CompactGlyphRef*)realloc(refs, refCapacity * 2 * sizeof(CompactGlyphRef));
+                if (!grown) { free(refs); return 0; }
+                refs = grown;
+                refCapacity *= 2;
+            }
+            refs[refCount].codepoint = (page << 8) | cell;
+            refs[refCount++].glyph = glyph;
+        }
     }
-    // Якщо символ не знайдено, повертаємо індекс пробілу (32)
-    return 32;
-}
+    qsort(refs, refCount, sizeof(CompactGlyphRef), CompareGlyphRefsByGlyph);
 
-// Функція завантаження PSF шрифту з файлу filename
-PSF_Font LoadPSFFont(const char* filename) {
-    FILE* f = fopen(filename, "rb");
+    FILE* f = fopen(filename, "wb");
     if (!f) {
-        printf("Не вдалося відкрити файл шрифту: %s\n", filename);
-        exit(1);
+        printf("Не вдалося відкрити файл для запису: %s\n", filename);
+        free(refs);
+        return 0;
     }
 
-    unsigned char magic[4] = {0};
-    fread(magic, 1, 4, f);  // Читаємо перші 4 байти для визначення формату
+    // Заголовок PSF2 (32 байти)
+    const unsigned char magic[4] = { PSF2_MAGIC0, PSF2_MAGIC1, PSF2_MAGIC2, PSF2_MAGIC3 };
+    fwrite(magic, 1, 4, f);
+    WriteLE32(f, 0);                        // version
+    WriteLE32(f, 32);                       // headersize
+    WriteLE32(f, PSF2_HAS_UNICODE_TABLE);   // flags
+    WriteLE32(f, (uint32_t)font->charcount);
+    WriteLE32(f, (uint32_t)font->charsize);
+    WriteLE32(f, (uint32_t)font->height);
+    WriteLE32(f, (uint32_t)font->width);
 
-    PSF_Font font = {0};     // Ініціалізуємо структуру шрифту нулями
+    // Гліфи (недоступний гліф посторінкового шрифту записується порожнім)
+    unsigned char* empty = (unsigned char*)calloc(1, font->charsize);
+    for (int c = 0; c < font->charcount; c++) {
+        const unsigned char* glyph = GetPSFGlyph(font, c);
+        fwrite(glyph ? glyph : empty, 1, font->charsize, f);
+    }
+    free(empty);
 
-    if (magic[0] == PSF1_MAGIC0 && magic[1] == PSF1_MAGIC1) {
-        // Якщо формат PSF1
-        fseek(f, 0, SEEK_SET); // Повертаємось на початок файлу
-        PSF1_Header header;
-        fread(&header, sizeof(PSF1_Header), 1, f);
+    // Unicode-таблиця: кодові точки кожного гліфа в UTF-8, завершені байтом 0xFF
+    size_t r = 0;
+    for (int c = 0; c < font->charcount; c++) {
+        for (; r < refCount && refs[r].glyph == c; r++) {
+            unsigned char utf8[4];
+            fwrite(utf8, 1, EncodeUTF8(refs[r].codepoint, utf8), f);
+        }
+        fputc(0xFF, f);
+    }
+    free(refs);
 
-        font.isPSF2 = 0;
-        font.width = 8;                   // Ширина символу в PSF1 завжди 8
-        font.height = header.charsize;   // Висота символу = розмір гліфа
-        font.charsize = header.charsize;
-        font.charcount = (header.mode & 0x01) ? 512 : 256; // Кількість символів
+    int ok = !ferror(f);
+    if (fclose(f) != 0) ok = 0;
+    if (!ok) printf("Не вдалося записати файл шрифту: %s\n", filename);
+    return ok;
+}
 
-        // Виділяємо пам’ять під гліфи та читаємо їх з файлу
-        font.glyphBuffer = (unsigned char*)malloc(font.charcount * font.charsize);
-        fread(font.glyphBuffer, font.charsize, font.charcount, f);
+// Покриття Unicode активною відповідністю шрифту (власна таблиця або вбудована ASCII + cyr_map):
+// повертає кількість кодових точок з гліфом, у *pages — біт p для сторінок U+p00..U+pFF (p < 64)
+int GetPSFUnicodeCoverage(const PSF_Font* font, uint64_t* pages) {
+    const UnicodeTable* map = font->unicodeTable;
+    if (!map) {
+        if (!builtin_table_ready) BuildBuiltinUnicodeTable();
+        map = &builtin_table;
     }
-    else if (magic[0] == PSF2_MAGIC0 && magic[1] == PSF2_MAGIC1 &&
-             magic[2] == PSF2_MAGIC2 && magic[3] == PSF2_MAGIC3) {
-        // Якщо формат PSF2
-        PSF2_Header header;
-        header.magic[0] = magic[0];
-        header.magic[1] = magic[1];
-        header.magic[2] = magic[2];
-        header.magic[3] = magic[3];
-        header.version = ReadLE32(f);
-        header.headersize = ReadLE32(f);
-        header.flags = ReadLE32(f);
-        header.length = ReadLE32(f);
-        header.charsize = ReadLE32(f);
-        header.height = ReadLE32(f);
-        header.width = ReadLE32(f);
 
-        font.isPSF2 = 1;
-        font.width = header.width;
-        font.height = header.height;
-        font.charcount = header.length;
-        font.charsize = header.charsize;
+    int count = 0;
+    uint64_t mask = 0;
+    for (uint32_t page = 0; page < UNICODE_TABLE_PAGES; page++) {
+        uint16_t pageNumber = map->pageIndex[page];
+        if (pageNumber == 0) continue;
+        int pageCount = 0;
+        for (uint32_t cell = 0; cell < 256; cell++) {
+            uint16_t glyph = map->pages[pageNumber][cell];
+            if (glyph != UNICODE_TABLE_NONE && glyph < font->charcount) pageCount++;
+        }
+        if (pageCount && page < 64) mask |= 1ull << page;
+        count += pageCount;
+    }
+    if (pages) *pages = mask;
+    return count;
+}
 
-        // Переходимо до початку гліфів (після заголовку)
-        fseek(f, header.headersize, SEEK_SET);
+// Перепакування гліфів у стиснутий формат у пам’яті (див. GlyphCompressor.h).
+// Межі «чорнила» лишаються; рядкові маски і розклад на прямокутники звільняються —
+// для великого шрифту вони займають більше за самі гліфи, а малювання піде через GetPSFGlyph.
+int CompressPSFFont(PSF_Font* font, int cacheSlots) {
+    if (!font->glyphBuffer) return 0;
 
-        // Виділяємо пам’ять і читаємо гліфи
-        font.glyphBuffer = (unsigned char*)malloc(font.charcount * font.charsize);
-        fread(font.glyphBuffer, 1, font.charcount * font.charsize, f);
-    }
-    else {
-        // Якщо формат не підтримується
-        printf("Формат шрифту не підтримується або файл пошкоджено\n");
-        fclose(f);
-        exit(1);
+    int bytes_per_row = (font->width + 7) / 8;
+    GlyphCompressor* compressor = GlyphCompressor_Create(font->glyphBuffer, font->charcount, font->charsize,
+                                                         bytes_per_row, font->height, cacheSlots);
+    if (!compressor) return 0;
+
+    // Стиснення має сенс лише тоді, коли разом з кешем займає менше
+    GlyphCompressorStats stats;
+    GlyphCompressor_GetStats(compressor, &stats);
+    if (stats.compressedBytes + stats.cacheBytes >= stats.rawBytes) {
+        GlyphCompressor_Free(compressor);
+        return 0;
     }
 
-    fclose(f);
-    return font;
+    switch (font->storage) {
+        case PSF_STORAGE_HEAP: free(font->glyphBuffer); break;
+        case PSF_STORAGE_MMAP: munmap(font->mapBase, font->mapSize); break;
+        default: break;
+    }
+    free(font->rowMasks);
+    free(font->glyphRects);
+    free(font->glyphRectStart);
+    font->rowMasks = NULL;
+    font->rowStride = 0;
+    font->glyphRects = NULL;
+    font->glyphRectStart = NULL;
+    font->glyphBuffer = NULL;
+    font->mapBase = NULL;
+    font->mapSize = 0;
+    font->compressor = compressor;
+    font->storage = PSF_STORAGE_COMPRESSED;
+    return 1;
 }
 
-// Функція звільнення пам’яті, виділеної під гліфи шрифту
-void UnloadPSFFont(PSF_Font font) {
-    free(font.glyphBuffer);
+// LoadPSFFont + CompressPSFFont (шрифт, що не стискається, лишається звичайним)
+PSF_Font LoadPSFFontCompressed(const char* filename, int cacheSlots) {
+    PSF_Font font = LoadPSFFont(filename);
+    CompressPSFFont(&font, cacheSlots);
+    return font;
 }
 
 // Функція малювання одного символу (гліфа) у позиції (x,y) кольором color
@@ -181,12 +1416,48 @@ void DrawPSFChar(PSF_Font font, int x, int y, int c, Color color) {
     int width = font.width;
     int height = font.height;
     int bytes_per_row = (width + 7) / 8; // Кількість байтів на один рядок гліфа
-    unsigned char* glyph = font.glyphBuffer + c * font.charsize; // Вказівник на гліф
+    const PSF_GlyphBounds* bounds = GetPSFGlyphBounds(&font, c);
+    int firstRow = 0, lastRow = height - 1;
+    int firstByte = 0, lastByte = bytes_per_row - 1;
+    if (bounds) {
+        if (bounds->isEmpty) return; // Порожній гліф (пробіл) — нічого не малюємо
+        firstRow = bounds->firstRow;
+        lastRow = bounds->lastRow;
+        firstByte = bounds->firstCol / 8;
+        lastByte = bounds->lastCol / 8;
+    }
+
+    int rectCount = 0;
+    const PSF_GlyphRect* rects = GetPSFGlyphRects(&font, c, &rectCount);
+    if (rects) {
+        // Гліф як кілька заповнених прямокутників замість окремих пікселів
+        for (int i = 0; i < rectCount; i++) {
+            DrawRectangle(x + rects[i].x, y + rects[i].y, rects[i].w, rects[i].h, color);
+        }
+        return;
+    }
+
+    const uint64_t* rows = GetPSFGlyphRows(&font, c);
+    if (rows) {
+        // Швидкий шлях: рядок — одне слово, обходимо лише встановлені біти
+        for (int row = firstRow; row <= lastRow; row++) {
+            uint64_t bits = rows[row];
+            while (bits) {
+                int px = __builtin_clzll(bits);          // Найлівіший встановлений піксель
+                bits &= ~(0x8000000000000000ULL >> px);  // Знімаємо його з маски
+                DrawPixel(x + px, y + row, color);
+            }
+        }
+        return;
+    }
+
+    const unsigned char* glyph = GetPSFGlyph(&font, c); // Вказівник на гліф
+    if (!glyph) return; // Сторінку гліфів не вдалося прочитати
 
     // Проходимо по кожному рядку гліфа
-    for (int row = 0; row < height; row++) {
+    for (int row = firstRow; row <= lastRow; row++) {
         // Проходимо по кожному байту в рядку
-        for (int byte = 0; byte < bytes_per_row; byte++) {
+        for (int byte = firstByte; byte <= lastByte; byte++) {
             unsigned char bits = glyph[row * bytes_per_row + byte]; // Поточний байт
             // Перевіряємо кожен біт у байті
             for (int bit = 0; bit < 8; bit++) {
@@ -201,39 +1472,87 @@ void DrawPSFChar(PSF_Font font, int x, int y, int c, Color color) {
     }
 }
 
-// Функція малювання тексту UTF-8 шрифтом PSF з підтримкою переносу рядків '\n'
-void DrawPSFText(PSF_Font font, int x, int y, const char* text, int spacing, Color color) {
+// Малює текст з курсора (UTF-8, UTF-32 або готові індекси гліфів)
+static void DrawPSFTextItems(PSF_Font font, int x, int y, PSF_TextCursor* cursor, int spacing, Color color) {
     int xpos = x; // Поточна позиція по горизонталі
     int ypos = y; // Поточна позиція по вертикалі
-    while (*text) {
-        if (*text == '\n') {
+    int glyph_index;
+    while ((glyph_index = NextPSFTextItem(cursor)) != PSF_TEXT_END) {
+        if (glyph_index == PSF_TEXT_NEWLINE) {
             // Обробка переносу рядка:
             // повертаємося в початок по x та зсуваємо y вниз на висоту символу + відступ
             xpos = x;
             ypos += font.height + spacing;
-            text++;
             continue;
         }
-        uint32_t codepoint = 0;
-        int bytes = utf8_decode(text, &codepoint); // Декодуємо один UTF-8 символ
-        int glyph_index = UnicodeToGlyphIndex(codepoint); // Знаходимо індекс гліфа
         if (glyph_index < 0) glyph_index = 32; // Якщо символ не знайдено — замінюємо пробілом
         DrawPSFChar(font, xpos, ypos, glyph_index, color); // Малюємо символ
         xpos += font.width + spacing; // Зсуваємо позицію по x для наступного символу
-        text += bytes; // Переходимо до наступного символу у тексті
     }
 }
 
+// Функція малювання тексту UTF-8 шрифтом PSF з підтримкою переносу рядків '\n'
+void DrawPSFText(PSF_Font font, int x, int y, const char* text, int spacing, Color color) {
+    // Той самий рядок щокадру — готова розкладка з кешу, без декодування
+    const PSF_PreparedText* run = GetPSFTextRun(&font, text, spacing, 1);
+    if (run) {
+        for (int i = 0; i < run->glyphCount; i++) {
+            const PSF_PreparedGlyph* g = &run->glyphs[i];
+            DrawPSFChar(font, x + g->x, y + g->y, g->glyph, color);
+        }
+        return;
+    }
+
+    PSF_TextCursor cursor;
+    InitPSFTextCursor(&cursor, &font, text);
+    DrawPSFTextItems(font, x, y, &cursor, spacing, color);
+}
+
 void DrawPSFCharScaled(PSF_Font font, int x, int y, int c, int scale, Color color) {
     if (c < 0 || c >= font.charcount) return;
 
     int width = font.width;
     int height = font.height;
     int bytes_per_row = (width + 7) / 8;
-    unsigned char* glyph = font.glyphBuffer + c * font.charsize;
+    const PSF_GlyphBounds* bounds = GetPSFGlyphBounds(&font, c);
+    int firstRow = 0, lastRow = height - 1;
+    int firstByte = 0, lastByte = bytes_per_row - 1;
+    if (bounds) {
+        if (bounds->isEmpty) return; // Порожній гліф (пробіл) — нічого не малюємо
+        firstRow = bounds->firstRow;
+        lastRow = bounds->lastRow;
+        firstByte = bounds->firstCol / 8;
+        lastByte = bounds->lastCol / 8;
+    }
+
+    int rectCount = 0;
+    const PSF_GlyphRect* rects = GetPSFGlyphRects(&font, c, &rectCount);
+    if (rects) {
+        for (int i = 0; i < rectCount; i++) {
+            DrawRectangle(x + rects[i].x * scale, y + rects[i].y * scale,
+                          rects[i].w * scale, rects[i].h * scale, color);
+        }
+        return;
+    }
+
+    const uint64_t* rows = GetPSFGlyphRows(&font, c);
+    if (rows) {
+        for (int row = firstRow; row <= lastRow; row++) {
+            uint64_t bits = rows[row];
+            while (bits) {
+                int px = __builtin_clzll(bits);
+                bits &= ~(0x8000000000000000ULL >> px);
+                DrawRectangle(x + px * scale, y + row * scale, scale, scale, color);
+            }
+        }
+        return;
+    }
 
-    for (int row = 0; row < height; row++) {
-        for (int byte = 0; byte < bytes_per_row; byte++) {
+    const unsigned char* glyph = GetPSFGlyph(&font, c);
+    if (!glyph) return;
+
+    for (int row = firstRow; row <= lastRow; row++) {
+        for (int byte = firstByte; byte <= lastByte; byte++) {
             unsigned char bits = glyph[row * bytes_per_row + byte];
             for (int bit = 0; bit < 8; bit++) {
                 int px = byte * 8 + bit;
@@ -247,67 +1566,545 @@ void DrawPSFCharScaled(PSF_Font font, int x, int y, int c, int scale, Color colo
     }
 }
 
-void DrawPSFTextScaled(PSF_Font font, int x, int y, const char* text, int spacing, int scale, Color color) {
+// Те саме з масштабом
+static void DrawPSFTextItemsScaled(PSF_Font font, int x, int y, PSF_TextCursor* cursor, int spacing, int scale, Color color) {
     int xpos = x;
     int ypos = y;
-    while (*text) {
-        if (*text == '\n') {
+    int glyph_index;
+    while ((glyph_index = NextPSFTextItem(cursor)) != PSF_TEXT_END) {
+        if (glyph_index == PSF_TEXT_NEWLINE) {
             xpos = x;
             ypos += (font.height * scale) + spacing;
-            text++;
             continue;
         }
-        uint32_t codepoint = 0;
-        int bytes = utf8_decode(text, &codepoint);
-        int glyph_index = UnicodeToGlyphIndex(codepoint);
         if (glyph_index < 0) glyph_index = 32;
         DrawPSFCharScaled(font, xpos, ypos, glyph_index, scale, color);
         xpos += (font.width * scale) + spacing;
-        text += bytes;
     }
 }
 
+void DrawPSFTextScaled(PSF_Font font, int x, int y, const char* text, int spacing, int scale, Color color) {
+    const PSF_PreparedText* run = GetPSFTextRun(&font, text, spacing, scale);
+    if (run) {
+        DrawPSFTextRun(&font, run, x, y, color);
+        return;
+    }
+
+    PSF_TextCursor cursor;
+    InitPSFTextCursor(&cursor, &font, text);
+    DrawPSFTextItemsScaled(font, x, y, &cursor, spacing, scale, color);
+}
+
+// Варіанти без завершального нуля і без повторного декодування (див. psf_font.h)
+void DrawPSFTextN(PSF_Font font, int x, int y, const char* text, size_t length, int spacing, Color color) {
+    PSF_TextCursor cursor;
+    InitPSFTextCursorN(&cursor, &font, text, length);
+    DrawPSFTextItems(font, x, y, &cursor, spacing, color);
+}
+
+void DrawPSFTextNScaled(PSF_Font font, int x, int y, const char* text, size_t length, int spacing, int scale, Color color) {
+    PSF_TextCursor cursor;
+    InitPSFTextCursorN(&cursor, &font, text, length);
+    DrawPSFTextItemsScaled(font, x, y, &cursor, spacing, scale, color);
+}
+
+void DrawPSFTextUTF32(PSF_Font font, int x, int y, const uint32_t* codepoints, size_t count, int spacing, Color color) {
+    PSF_TextCursor cursor;
+    InitPSFTextCursorUTF32(&cursor, &font, codepoints, count);
+    DrawPSFTextItems(font, x, y, &cursor, spacing, color);
+}
+
+void DrawPSFTextUTF32Scaled(PSF_Font font, int x, int y, const uint32_t* codepoints, size_t count, int spacing, int scale, Color color) {
+    PSF_TextCursor cursor;
+    InitPSFTextCursorUTF32(&cursor, &font, codepoints, count);
+    DrawPSFTextItemsScaled(font, x, y, &cursor, spacing, scale, color);
+}
+
+void DrawPSFGlyphs(PSF_Font font, int x, int y, const int32_t* glyphs, size_t count, int spacing, Color color) {
+    PSF_TextCursor cursor;
+    InitPSFTextCursorGlyphs(&cursor, glyphs, count);
+    DrawPSFTextItems(font, x, y, &cursor, spacing, color);
+}
+
+void DrawPSFGlyphsScaled(PSF_Font font, int x, int y, const int32_t* glyphs, size_t count, int spacing, int scale, Color color) {
+    PSF_TextCursor cursor;
+    InitPSFTextCursorGlyphs(&cursor, glyphs, count);
+    DrawPSFTextItemsScaled(font, x, y, &cursor, spacing, scale, color);
+}
+
+// Малювання тексту ланцюжком запасних шрифтів (FontFallback): кожен символ береться з першого
+// шрифту ланцюжка, що має гліф, через кеш ланцюжка. Висоту рядка задає основний шрифт, гліф
+// іншої висоти центрується в рядку, а позиція зсувається на ширину шрифту, з якого взято гліф.
+void DrawPSFTextFallbackScaled(struct FontFallback* fallback, int x, int y, const char* text, int spacing, int scale, Color color) {
+    const PSF_Font* primary = FontFallback_GetPrimary(fallback);
+    if (!primary) return;
+    FontFallback_Revalidate(fallback);
+
+    int xpos = x;
+    int ypos = y;
+    PSF_TextCursor cursor;
+    InitPSFTextCursor(&cursor, NULL, text);
+    int codepoint;
+    while ((codepoint = NextPSFTextItem(&cursor)) != PSF_TEXT_END) {
+        if (codepoint == PSF_TEXT_NEWLINE) {
+            xpos = x;
+            ypos += (primary->height * scale) + spacing;
+            continue;
+        }
+        FontFallbackGlyph g = FontFallback_Resolve(fallback, codepoint);
+        int yoffset = (primary->height - g.font->height) / 2 * scale;
+        DrawPSFCharScaled(*g.font, xpos, ypos + yoffset, g.glyph, scale, color);
+        xpos += (g.font->width * scale) + spacing;
+    }
+}
+
+void DrawPSFTextFallback(struct FontFallback* fallback, int x, int y, const char* text, int spacing, Color color) {
+    DrawPSFTextFallbackScaled(fallback, x, y, text, spacing, 1, color);
+}
+
+// Малювання тексту, повернутого на rotation градусів (90, 180, 270) проти годинникової стрілки
+// навколо точки (x, y) — лівого верхнього кута тексту до повороту. Гліфи беруться з повернутої
+// копії шрифту (GetPSFRotatedFont), тому малювання йде тим самим шляхом, що й горизонтальне.
+void DrawPSFTextRotatedScaled(PSF_Font font, int x, int y, const char* text, int spacing, int rotation, int scale, Color color) {
+    const PSF_Font* rotated = GetPSFRotatedFont(&font, rotation);
+    if (!rotated) return;
+    rotation = NormalizePSFRotation(rotation);
+
+    int cellWidth = font.width * scale;
+    int cellHeight = font.height * scale;
+    int u = 0, v = 0;  // Позиція комірки символу в тексті до повороту
+    PSF_TextCursor cursor;
+    InitPSFTextCursor(&cursor, &font, text);
+    int glyph_index;
+    while ((glyph_index = NextPSFTextItem(&cursor)) != PSF_TEXT_END) {
+        if (glyph_index == PSF_TEXT_NEWLINE) {
+            u = 0;
+            v += cellHeight + spacing;
+            continue;
+        }
+        if (glyph_index < 0) glyph_index = 32;
+
+        // Лівий верхній кут повернутої комірки
+        int gx, gy;
+        switch (rotation) {
+            case 90:  gx = x + v;              gy = y - u - cellWidth;  break;
+            case 180: gx = x - u - cellWidth;  gy = y - v - cellHeight; break;
+            case 270: gx = x - v - cellHeight; gy = y + u;              break;
+            default:  gx = x + u;              gy = y + v;              break;
+        }
+        DrawPSFCharScaled(*rotated, gx, gy, glyph_index, scale, color);
+        u += cellWidth + spacing;
+    }
+}
+
+void DrawPSFTextRotated(PSF_Font font, int x, int y, const char* text, int spacing, int rotation, Color color) {
+    DrawPSFTextRotatedScaled(font, x, y, text, spacing, rotation, 1, color);
+}
+
+// Малювання тексту стилізованою копією шрифту: розкладка і пошук гліфів — за вихідним шрифтом,
+// біти гліфів — зі стилізованої копії, по одному виклику DrawPSFCharScaled на символ
+void DrawPSFTextStyledScaled(PSF_Font font, int x, int y, const char* text, int spacing, int style, int scale, Color color) {
+    const PSF_Font* styled = GetPSFStyledFont(&font, style);
+    if (!styled) return;
+
+    int pad = GetPSFStylePadding(style) * scale;
+    int xpos = x;
+    int ypos = y;
+    PSF_TextCursor cursor;
+    InitPSFTextCursor(&cursor, &font, text);
+    int glyph_index;
+    while ((glyph_index = NextPSFTextItem(&cursor)) != PSF_TEXT_END) {
+        if (glyph_index == PSF_TEXT_NEWLINE) {
+            xpos = x;
+            ypos += (font.height * scale) + spacing;
+            continue;
+        }
+        if (glyph_index < 0) glyph_index = 32;
+        DrawPSFCharScaled(*styled, xpos - pad, ypos - pad, glyph_index, scale, color);
+        xpos += (font.width * scale) + spacing;
+    }
+}
+
+void DrawPSFTextStyled(PSF_Font font, int x, int y, const char* text, int spacing, int style, Color color) {
+    DrawPSFTextStyledScaled(font, x, y, text, spacing, style, 1, color);
+}
+
+// Текст з обведенням і/або тінню: спершу оздоблення кольором decorationColor, потім сам текст
+// (BOLD/ITALIC зі style) кольором textColor — два виклики на символ замість 5–9 зсунутих копій
+void DrawPSFTextDecorated(PSF_Font font, int x, int y, const char* text, int spacing, int style, int scale,
+                          Color textColor, Color decorationColor) {
+    if (style & (PSF_STYLE_OUTLINE | PSF_STYLE_SHADOW)) {
+        DrawPSFTextStyledScaled(font, x, y, text, spacing, style, scale, decorationColor);
+    }
+    DrawPSFTextStyledScaled(font, x, y, text, spacing, style & (PSF_STYLE_BOLD | PSF_STYLE_ITALIC), scale, textColor);
+}
+
+// Кодові точки в індекси гліфів (font == NULL — кодові точки як є), '\n' — PSF_TEXT_NEWLINE.
+// out може збігатися з codepoints.
+static void MapPSFCodepoints(const PSF_Font* font, const uint32_t* codepoints, size_t count, int32_t* out) {
+    for (size_t i = 0; i < count; i++) {
+        uint32_t codepoint = codepoints[i];
+        if (codepoint == '\n') {
+            out[i] = PSF_TEXT_NEWLINE;
+        } else {
+            out[i] = font ? FontUnicodeToGlyphIndex(font, codepoint) : (int32_t)codepoint;
+        }
+    }
+}
+
+// Текст UTF-8 → індекси гліфів шрифту font (або кодові точки, якщо font == NULL) пакетом:
+// Utf8Decoder перевіряє й декодує одразу до capacity символів (ASCII — блоками SIMD),
+// далі кожна кодова точка — одне звернення до Unicode-таблиці. Масив out спершу
+// отримує кодові точки і перезаписується індексами на місці.
+size_t DecodePSFText(const PSF_Font* font, const char* text, size_t length, int32_t* out, size_t capacity, size_t* consumed) {
+    uint32_t* codepoints = (uint32_t*)out;
+    size_t count = Utf8Decoder_Decode(text, length, codepoints, capacity, consumed);
+    MapPSFCodepoints(font, codepoints, count, out);
+    return count;
+}
+
+void InitPSFTextCursorN(PSF_TextCursor* cursor, const PSF_Font* font, const char* text, size_t length) {
+    cursor->font = font;
+    cursor->text = text;
+    cursor->codepoints = NULL;
+    cursor->glyphs = NULL;
+    cursor->remaining = length;
+    cursor->count = 0;
+    cursor->pos = 0;
+}
+
+void InitPSFTextCursor(PSF_TextCursor* cursor, const PSF_Font* font, const char* text) {
+    InitPSFTextCursorN(cursor, font, text, strlen(text));
+}
+
+void InitPSFTextCursorUTF32(PSF_TextCursor* cursor, const PSF_Font* font, const uint32_t* codepoints, size_t count) {
+    InitPSFTextCursorN(cursor, font, NULL, count);
+    cursor->codepoints = codepoints;
+}
+
+void InitPSFTextCursorGlyphs(PSF_TextCursor* cursor, const int32_t* glyphs, size_t count) {
+    InitPSFTextCursorN(cursor, NULL, NULL, count);
+    cursor->glyphs = glyphs;
+}
+
+// Порція готового входу курсора: кодові точки лише перетворюються в індекси, індекси гліфів
+// копіюються (значення PSF_TEXT_END та інші від’ємні, крім переносу, стають пробілом)
+static void FillPSFTextCursor(PSF_TextCursor* cursor) {
+    size_t count = cursor->remaining < PSF_TEXT_CHUNK ? cursor->remaining : PSF_TEXT_CHUNK;
+    if (cursor->codepoints) {
+        MapPSFCodepoints(cursor->font, cursor->codepoints, count, cursor->items);
+        cursor->codepoints += count;
+    } else {
+        for (size_t i = 0; i < count; i++) {
+            int32_t glyph = cursor->glyphs[i];
+            cursor->items[i] = glyph < PSF_TEXT_NEWLINE ? 32 : glyph;
+        }
+        cursor->glyphs += count;
+    }
+    cursor->count = (int)count;
+    cursor->remaining -= count;
+}
+
+// Наступний гліф (кодова точка) тексту; нова порція декодується, коли попередня вичерпана
+int NextPSFTextItem(PSF_TextCursor* cursor) {
+    if (cursor->pos == cursor->count) {
+        if (cursor->remaining == 0) return PSF_TEXT_END;
+        if (cursor->text) {
+            size_t consumed = 0;
+            cursor->count = (int)DecodePSFText(cursor->font, cursor->text, cursor->remaining,
+                                               cursor->items, PSF_TEXT_CHUNK, &consumed);
+            cursor->text += consumed;
+            cursor->remaining -= consumed;
+        } else {
+            FillPSFTextCursor(cursor);
+        }
+        cursor->pos = 0;
+    }
+    return cursor->items[cursor->pos++];
+}
+
+// Підготовка тексту для багаторазового малювання: декодування UTF-8, пошук гліфів і розкладка
+// виконуються тут один раз. Порожні гліфи (пробіли) відкидаються одразу. Текст і масиви
+// займають один блок пам’яті (FreePreparedPSFText). NULL — якщо бракує пам’яті.
+PSF_PreparedText* PreparePSFText(const PSF_Font* font, const char* text, int spacing, int scale) {
+    if (!font || !text) return NULL;
+    if (scale <= 0) scale = 1;
+
+    // Кожен байт дає не більше одного гліфа; рядків — на один більше, ніж переносів
+    size_t length = strlen(text);
+    int32_t* items = (int32_t*)malloc((length + 1) * sizeof(int32_t));
+    if (!items) return NULL;
+    int count = (int)DecodePSFText(font, text, length, items, length, NULL);
+    int lineCount = 1;
+    for (int i = 0; i < count; i++) {
+        if (items[i] == PSF_TEXT_NEWLINE) lineCount++;
+    }
+
+    size_t size = sizeof(PSF_PreparedText) + (size_t)count * sizeof(PSF_PreparedGlyph) +
+                  (size_t)(lineCount + 1) * sizeof(int);
+    PSF_PreparedText* prepared = (PSF_PreparedText*)malloc(size);
+    if (!prepared) {
+        free(items);
+        return NULL;
+    }
+    prepared->font = font;
+    prepared->scale = scale;
+    prepared->glyphs = (PSF_PreparedGlyph*)(prepared + 1);
+    prepared->lineStart = (int*)(prepared->glyphs + count);
+    prepared->lineCount = lineCount;
+
+    int advance = (font->width * scale) + spacing;
+    int lineHeight = (font->height * scale) + spacing;
+    int glyphCount = 0, line = 0, column = 0, maxColumns = 0;
+    prepared->lineStart[0] = 0;
+    for (int i = 0; i < count; i++) {
+        int glyph = items[i];
+        if (glyph == PSF_TEXT_NEWLINE) {
+            prepared->lineStart[++line] = glyphCount;
+            column = 0;
+            continue;
+        }
+        if (glyph < 0 || glyph >= font->charcount) glyph = 32;
+        const PSF_GlyphBounds* bounds = GetPSFGlyphBounds(font, glyph);
+        if (!bounds || !bounds->isEmpty) {
+            PSF_PreparedGlyph* g = &prepared->glyphs[glyphCount++];
+            g->glyph = glyph;
+            g->x = column * advance;
+            g->y = line * lineHeight;
+        }
+        column++;
+        if (column > maxColumns) maxColumns = column;
+    }
+    prepared->lineStart[lineCount] = glyphCount;
+    prepared->glyphCount = glyphCount;
+    prepared->width = maxColumns > 0 ? maxColumns * advance - spacing : 0;
+    prepared->height = lineCount * lineHeight - spacing;
+    free(items);
+    return prepared;
+}
+
+void FreePreparedPSFText(PSF_PreparedText* text) {
+    free(text);
+}
+
+// Вивід гліфів розкладки за готовими позиціями шрифтом font (розкладки кешу шрифту не зберігають)
+static void DrawPSFTextRun(const PSF_Font* font, const PSF_PreparedText* text, int x, int y, Color color) {
+    for (int i = 0; i < text->glyphCount; i++) {
+        const PSF_PreparedGlyph* g = &text->glyphs[i];
+        DrawPSFCharScaled(*font, x + g->x, y + g->y, g->glyph, text->scale, color);
+    }
+}
+
+// Малювання підготовленого тексту: лише вивід гліфів за готовими позиціями
+void DrawPreparedPSFText(const PSF_PreparedText* text, int x, int y, Color color) {
+    if (!text || !text->font) return;
+    DrawPSFTextRun(text->font, text, x, y, color);
+}
+
+// Кеш розкладених рядків для малювання щокадру. Ключ — serial шрифту, хеш FNV-1a рядка, spacing
+// і scale; сам рядок зберігається і порівнюється повністю, тож колізія хешу не дає чужого тексту.
+// Записи зв’язані у список LRU (голова — щойно використаний), повний кеш витісняє хвіст.
+#define PSF_TEXT_RUN_BUCKETS 256        // Кошиків хеш-таблиці (степінь двійки)
+#define PSF_TEXT_RUN_NONE (-1)
+
+typedef struct {
+    uint64_t hash;
+    uint32_t serial;             // 0 — запис вільний
+    int spacing;
+    int scale;
+    char* text;                  // Копія рядка (length байтів без нуля)
+    size_t length;
+    PSF_PreparedText* run;
+    int prev, next;              // Сусіди у списку LRU
+    int chain;                   // Наступний запис того самого кошика
+} PSF_TextRun;
+
+static PSF_TextRun g_textRuns[PSF_TEXT_RUN_CACHE_SIZE];
+static int g_textRunBuckets[PSF_TEXT_RUN_BUCKETS];
+static int g_textRunHead = PSF_TEXT_RUN_NONE;
+static int g_textRunTail = PSF_TEXT_RUN_NONE;
+static int g_textRunCount = 0;
+static int g_textRunsReady = 0;
+static PSF_TextRunCacheStats g_textRunStats;
+
+static void InitPSFTextRuns(void) {
+    for (int i = 0; i < PSF_TEXT_RUN_BUCKETS; i++) g_textRunBuckets[i] = PSF_TEXT_RUN_NONE;
+    g_textRunsReady = 1;
+}
+
+static void UnlinkPSFTextRun(int index) {
+    PSF_TextRun* entry = &g_textRuns[index];
+    if (entry->prev != PSF_TEXT_RUN_NONE) g_textRuns[entry->prev].next = entry->next;
+    else g_textRunHead = entry->next;
+    if (entry->next != PSF_TEXT_RUN_NONE) g_textRuns[entry->next].prev = entry->prev;
+    else g_textRunTail = entry->prev;
+}
+
+static void PushPSFTextRun(int index) {
+    PSF_TextRun* entry = &g_textRuns[index];
+    entry->prev = PSF_TEXT_RUN_NONE;
+    entry->next = g_textRunHead;
+    if (g_textRunHead != PSF_TEXT_RUN_NONE) g_textRuns[g_textRunHead].prev = index;
+    else g_textRunTail = index;
+    g_textRunHead = index;
+}
+
+static void RemovePSFTextRun(int index) {
+    PSF_TextRun* entry = &g_textRuns[index];
+    int* link = &g_textRunBuckets[entry->hash & (PSF_TEXT_RUN_BUCKETS - 1)];
+    while (*link != index) link = &g_textRuns[*link].chain;
+    *link = entry->chain;
+    UnlinkPSFTextRun(index);
+    FreePreparedPSFText(entry->run);
+    free(entry->text);
+    entry->run = NULL;
+    entry->text = NULL;
+    entry->serial = 0;
+    g_textRunCount--;
+}
+
+// Звільняє розкладки шрифту з номером serial (розкладка залежить від Unicode-таблиці й гліфів)
+static void ForgetPSFTextRuns(uint32_t serial) {
+    if (!g_textRunsReady || serial == 0) return;
+    for (int i = 0; i < PSF_TEXT_RUN_CACHE_SIZE; i++) {
+        if (g_textRuns[i].serial == serial) RemovePSFTextRun(i);
+    }
+}
+
+const PSF_PreparedText* GetPSFTextRun(const PSF_Font* font, const char* text, int spacing, int scale) {
+    if (!font || !text) return NULL;
+    // Шрифт без serial (зібраний вручну) не можна відрізнити від іншого такого ж
+    if (font->serial == 0 || scale <= 0) {
+        g_textRunStats.bypassed++;
+        return NULL;
+    }
+    if (!g_textRunsReady) InitPSFTextRuns();
+
+    // Хеш і довжина за один прохід; довгий рядок малюється без кешу
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    size_t length = 0;
+    for (const unsigned char* p = (const unsigned char*)text; *p; p++) {
+        if (++length > PSF_TEXT_RUN_MAX_BYTES) {
+            g_textRunStats.bypassed++;
+            return NULL;
+        }
+        hash = (hash ^ *p) * 0x100000001b3ULL;
+    }
+    hash = (hash ^ font->serial) * 0x100000001b3ULL;
+
+    int* bucket = &g_textRunBuckets[hash & (PSF_TEXT_RUN_BUCKETS - 1)];
+    for (int i = *bucket; i != PSF_TEXT_RUN_NONE; i = g_textRuns[i].chain) {
+        PSF_TextRun* entry = &g_textRuns[i];
+        if (entry->hash == hash && entry->serial == font->serial && entry->spacing == spacing &&
+            entry->scale == scale && entry->length == length && memcmp(entry->text, text, length) == 0) {
+            if (g_textRunHead != i) {
+                UnlinkPSFTextRun(i);
+                PushPSFTextRun(i);
+            }
+            g_textRunStats.hits++;
+            return entry->run;
+        }
+    }
+
+    PSF_PreparedText* run = PreparePSFText(font, text, spacing, scale);
+    char* copy = (char*)malloc(length ? length : 1);
+    if (!run || !copy) {
+        FreePreparedPSFText(run);
+        free(copy);
+        g_textRunStats.bypassed++;
+        return NULL;
+    }
+    // Шрифт викликача часто є копією на стеку: запис знає лише serial, шрифт дає кожне малювання
+    run->font = NULL;
+    memcpy(copy, text, length);
+    g_textRunStats.misses++;
+
+    int index;
+    if (g_textRunCount == PSF_TEXT_RUN_CACHE_SIZE) {
+        index = g_textRunTail;
+        RemovePSFTextRun(index);
+        g_textRunStats.evictions++;
+    } else {
+        index = 0;
+        while (g_textRuns[index].serial != 0) index++;
+    }
+
+    PSF_TextRun* entry = &g_textRuns[index];
+    entry->hash = hash;
+    entry->serial = font->serial;
+    entry->spacing = spacing;
+    entry->scale = scale;
+    entry->text = copy;
+    entry->length = length;
+    entry->run = run;
+    entry->chain = *bucket;
+    *bucket = index;
+    PushPSFTextRun(index);
+    g_textRunCount++;
+    return run;
+}
+
+void GetPSFTextRunCacheStats(PSF_TextRunCacheStats* stats) {
+    *stats = g_textRunStats;
+    stats->entries = g_textRunCount;
+    stats->capacity = PSF_TEXT_RUN_CACHE_SIZE;
+}
+
+void ClearPSFTextRunCache(void) {
+    if (!g_textRunsReady) return;
+    for (int i = 0; i < PSF_TEXT_RUN_CACHE_SIZE; i++) {
+        if (g_textRuns[i].serial != 0) RemovePSFTextRun(i);
+    }
+}
+
+// Копія text без порожніх рядків (переносів на початку, в кінці й поспіль) — так її розбиває strtok.
+// 0 — якщо результат порожній, text не вміщується в size байтів або має понад maxLines рядків.
+static int CollapsePSFTextLines(const char* text, char* out, size_t size, int maxLines) {
+    size_t n = 0;
+    int lines = 0;
+    for (size_t i = 0; text[i]; i++) {
+        if (i + 1 >= size) return 0;
+        if (text[i] == '\n') continue;
+        if (i == 0 || text[i - 1] == '\n') {
+            if (++lines > maxLines) return 0;
+            if (n > 0) out[n++] = '\n';
+        }
+        out[n++] = text[i];
+    }
+    out[n] = '\0';
+    return n > 0;
+}
+
 /* strlen рахує байти, а не символи UTF-8,
  * тому для кирилиці (2-3 байти на символ) ширина вважається завищеною.
  * Використання utf8_strlen поверне правильну кількість символів. */
 int utf8_strlen(const char* s) {
-    int len = 0;
-    while (*s) {
-        uint32_t codepoint = 0;
-        int bytes = utf8_decode(s, &codepoint); // ваша функція декодування UTF-8
-        s += bytes;
-        len++;
-    }
-    return len;
+    return (int)Utf8Decoder_Count(s, strlen(s));
 }
 
 // Малює рядок тексту без масштабування з пробілами та кирилицею
 void DrawPSFCharLine(PSF_Font font, int x, int y, const char* text, int spacing, Color color) {
     int xpos = x;
-    const char* p = text;
-    while (*p) {
-        uint32_t codepoint = 0;
-        int bytes = utf8_decode(p, &codepoint);
-        int glyph_index = UnicodeToGlyphIndex(codepoint);
+    PSF_TextCursor cursor;
+    InitPSFTextCursor(&cursor, &font, text);
+    int glyph_index;
+    while ((glyph_index = NextPSFTextItem(&cursor)) != PSF_TEXT_END) {
         if (glyph_index < 0) glyph_index = 32;
         DrawPSFChar(font, xpos, y, glyph_index, color);
         xpos += font.width + spacing;
-        p += bytes;
     }
 }
 
 // Малює рядок тексту з масштабуванням
 void DrawPSFCharLineScaled(PSF_Font font, int x, int y, const char* text, int spacing, int scale, Color color) {
     int xpos = x;
-    const char* p = text;
-    while (*p) {
-        uint32_t codepoint = 0;
-        int bytes = utf8_decode(p, &codepoint);
-        int glyph_index = UnicodeToGlyphIndex(codepoint);
+    PSF_TextCursor cursor;
+    InitPSFTextCursor(&cursor, &font, text);
+    int glyph_index;
+    while ((glyph_index = NextPSFTextItem(&cursor)) != PSF_TEXT_END) {
         if (glyph_index < 0) glyph_index = 32;
         DrawPSFCharScaled(font, xpos, y, glyph_index, scale, color);
         xpos += (font.width * scale) + spacing;
-        p += bytes;
     }
 }
 
@@ -364,6 +2161,22 @@ void DrawPSFTextWithInvertedBackground(PSF_Font font, int x, int y, const char*
 // Аналогічна масштабована версія функції з інверсним фоном
 void DrawPSFTextScaledWithInvertedBackground(PSF_Font font, int x, int y, const char* text, int spacing, int scale, Color textColor, int padding)
 {
+    // Той самий напис щокадру — габарит і гліфи з кешу розкладок
+    char collapsed[PSF_TEXT_RUN_MAX_BYTES + 1];
+    const PSF_PreparedText* run = NULL;
+    if (CollapsePSFTextLines(text, collapsed, sizeof(collapsed), 20)) {
+        run = GetPSFTextRun(&font, collapsed, spacing, scale);
+    }
+    if (run) {
+        float bgWidth  = run->width + 2 * padding;
+        float bgHeight = run->height + 2 * padding;
+        Color bgColor = GetContrastingInvertedBackground(textColor);
+        DrawRectangle(x - padding, y - padding, bgWidth, bgHeight, bgColor);
+        DrawRectangleLines(x - padding, y - padding, bgWidth, bgHeight, textColor);
+        DrawPSFTextRun(&font, run, x, y, textColor);
+        return;
+    }
+
     const char* lines[20];   // Массив рядків тексту
     int lineCount = 0;       // Кількість рядків
     char tempText[512];      // Тимчасовий буфер для копії тексту
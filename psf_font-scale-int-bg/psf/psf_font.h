@@ -4,6 +4,40 @@
 #include "raylib.h"
 #include <stdint.h>
 #include <stddef.h>
+#include "UnicodeTable.h"
+#include "GlyphPager.h"
+#include "GlyphCompressor.h"
+
+// Звідки взято пам’ять гліфів (визначає, як її звільняти)
+typedef enum {
+    PSF_STORAGE_HEAP = 0,   // malloc + fread (LoadPSFFont)
+    PSF_STORAGE_MMAP,       // відображення файлу (LoadPSFFontMapped)
+    PSF_STORAGE_MEMORY,     // зовнішній буфер (LoadPSFFontFromMemory), не звільняється
+    PSF_STORAGE_PAGED,      // сторінки гліфів читаються на вимогу (LoadPSFFontPaged)
+    PSF_STORAGE_COMPRESSED  // гліфи стиснуті в пам’яті й розпаковуються на вимогу (CompressPSFFont)
+} PSF_Storage;
+
+// Межі «чорнила» гліфа, обчислені при завантаженні
+typedef struct {
+    uint16_t firstRow, lastRow;  // Перший і останній рядки з хоча б одним пікселем
+    uint16_t firstCol, lastCol;  // Перший і останній стовпці з хоча б одним пікселем
+    uint8_t isEmpty;             // 1 — гліф без жодного пікселя (пробіл), решта полів нульові
+} PSF_GlyphBounds;
+
+// Прямокутник з розкладу гліфа (координати в пікселях відносно комірки символу)
+typedef struct {
+    uint16_t x, y;               // Лівий верхній кут
+    uint16_t w, h;               // Ширина і висота
+} PSF_GlyphRect;
+
+// Синтетичні стилі шрифту (можна поєднувати), див. GetPSFStyledFont
+typedef enum {
+    PSF_STYLE_REGULAR = 0,
+    PSF_STYLE_BOLD    = 1 << 0,  // Жирний: кожен рядок OR з собою, зсунутим на 1 піксель
+    PSF_STYLE_ITALIC  = 1 << 1,  // Курсив: зсув рядків пропорційно висоті
+    PSF_STYLE_OUTLINE = 1 << 2,  // Лише обведення товщиною 1 піксель навколо гліфа
+    PSF_STYLE_SHADOW  = 1 << 3   // Лише тінь, зсунута на 1 піксель вправо-вниз
+} PSF_Style;
 
 // Структура шрифту PSF1/PSF2
 typedef struct {
@@ -13,14 +47,191 @@ typedef struct {
     int charcount;          // Кількість гліфів (символів) у шрифті
     int charsize;           // Розмір одного гліфа в байтах
     unsigned char* glyphBuffer; // Вказівник на буфер з бінарними даними гліфів
+    PSF_Storage storage;    // Походження пам’яті гліфів
+    void* mapBase;          // Початок mmap-відображення файлу (NULL, якщо гліфи в купі)
+    size_t mapSize;         // Розмір відображення в байтах
+    UnicodeTable* unicodeTable; // Unicode-таблиця з файлу шрифту (NULL, якщо її немає)
+    GlyphPager* pager;      // Таблиця сторінок гліфів (лише для PSF_STORAGE_PAGED, тоді glyphBuffer == NULL)
+    GlyphCompressor* compressor; // Стиснуті гліфи (лише для PSF_STORAGE_COMPRESSED, тоді glyphBuffer == NULL)
+    uint64_t* rowMasks;     // Гліфи як рядкові маски uint64_t (NULL, якщо не побудовано BuildPSFRowMasks)
+    int rowStride;          // Кількість масок на гліф (кратна 8, тобто 64 байти)
+    PSF_GlyphBounds* glyphBounds; // Межі «чорнила» кожного гліфа (NULL для посторінкового шрифту)
+    PSF_GlyphRect* glyphRects;    // Розклад усіх гліфів на прямокутники (NULL, якщо не побудовано)
+    uint32_t* glyphRectStart;     // Початок прямокутників гліфа c у glyphRects (charcount + 1 елементів)
+    uint32_t serial;        // Унікальний номер завантаження (не повторюється) — ключ для залежних кешів
 } PSF_Font;
 
-// Функція завантаження PSF шрифту з файлу за шляхом filename
+// Символів, що декодуються за один прохід курсора тексту (PSF_TextCursor)
+#define PSF_TEXT_CHUNK 128
+
+// Особливі значення в масиві DecodePSFText і з NextPSFTextItem
+#define PSF_TEXT_NEWLINE (-1)   // Перенос рядка '\n'
+#define PSF_TEXT_END     (-2)   // Текст закінчився (лише NextPSFTextItem)
+
+// Курсор тексту для циклів малювання: UTF-8 декодується і перетворюється в індекси гліфів
+// порціями по PSF_TEXT_CHUNK символів (DecodePSFText), а не по символу за виклик.
+// Вхід UTF-32 лише перетворюється в індекси, готові індекси гліфів видаються як є.
+typedef struct {
+    const PSF_Font* font;           // Шрифт для індексів гліфів (NULL — курсор видає кодові точки)
+    const char* text;               // Ще не декодований залишок тексту
+    const uint32_t* codepoints;     // Або залишок кодових точок UTF-32
+    const int32_t* glyphs;          // Або залишок готових індексів гліфів
+    size_t remaining;               // Його довжина в байтах (в елементах для UTF-32 і гліфів)
+    int32_t items[PSF_TEXT_CHUNK];  // Декодована порція
+    int count;                      // Елементів у порції
+    int pos;                        // Наступний елемент порції
+} PSF_TextCursor;
+
+// Гліф підготовленого тексту (PreparePSFText)
+typedef struct {
+    int32_t glyph;           // Індекс гліфа у шрифті
+    int32_t x, y;            // Лівий верхній кут комірки від початку тексту (з масштабом)
+} PSF_PreparedGlyph;
+
+// Підготовлений текст: UTF-8 декодовано, гліфи знайдено і розкладено один раз,
+// тож малювання щокадру (DrawPreparedPSFText) лише виводить гліфи за готовими позиціями.
+// Незмінний після PreparePSFText; шрифт має жити довше за текст.
+typedef struct {
+    const PSF_Font* font;        // Шрифт, для якого розкладено текст
+    int scale;                   // Масштаб гліфів
+    PSF_PreparedGlyph* glyphs;   // Непорожні гліфи (пробіли не зберігаються)
+    int glyphCount;
+    int* lineStart;              // Перший гліф кожного рядка в glyphs (lineCount + 1 елементів)
+    int lineCount;               // Кількість рядків (переноси '\n' + 1)
+    int width, height;           // Габарит тексту в пікселях (найдовший рядок × усі рядки)
+} PSF_PreparedText;
+
+// Кеш розкладених рядків: записів (витісняється найдавніше використаний) і найдовший рядок у байтах
+#define PSF_TEXT_RUN_CACHE_SIZE 128
+#define PSF_TEXT_RUN_MAX_BYTES 256
+
+// Статистика кешу розкладених рядків (GetPSFTextRunCacheStats)
+typedef struct {
+    unsigned long hits;          // Малювань з готової розкладки
+    unsigned long misses;        // Рядків, розкладених і доданих до кешу
+    unsigned long evictions;     // Записів, витіснених новими рядками
+    unsigned long bypassed;      // Малювань без кешу (довгий рядок, шрифт без serial)
+    int entries;                 // Записів у кеші зараз
+    int capacity;                // PSF_TEXT_RUN_CACHE_SIZE
+} PSF_TextRunCacheStats;
+
+// Обробник звільнення шрифту: викликається з UnloadPSFFont до звільнення даних
+typedef void (*PSF_UnloadHook)(const PSF_Font* font);
+
+// Обробник зміни гліфа glyphIndex після ReloadPSFFontInPlace (font — уже нова версія)
+typedef void (*PSF_GlyphChangedHook)(const PSF_Font* font, int glyphIndex);
+
+// Функція завантаження PSF шрифту з файлу за шляхом filename.
+// Стиснуті шрифти (.psf.gz, .psfu.gz) розпаковуються потоково через zlib прямо в буфер гліфів.
 PSF_Font LoadPSFFont(const char* filename);
 
+// Те саме без завершення програми: повертає 1 при успіху, 0 при помилці
+// (для фонового завантаження, див. AsyncFontLoader.h)
+int TryLoadPSFFont(const char* filename, PSF_Font* out);
+
+// Запис шрифту у файл PSF2 з Unicode-таблицею активної відповідності (власна таблиця або
+// ASCII + cyr_map для PSF1 без таблиці): канонічний формат для перетворення PSF1 і для підмножин
+// (CompactPSFFont + SavePSFFont). Повертає 1 при успіху, 0 при помилці запису.
+int SavePSFFont(const PSF_Font* font, const char* filename);
+
+// Завантаження PSF шрифту через mmap без копіювання гліфів
+// (сторінки шрифту спільні між процесами, звільнення — через UnloadPSFFont).
+// Стиснутий шрифт відобразити не можна — він завантажується як LoadPSFFont.
+PSF_Font LoadPSFFontMapped(const char* filename);
+
+// Посторінкове завантаження гліфів на вимогу для великих шрифтів (десятки тисяч гліфів):
+// у пам’яті лишаються лише сторінки з використаними гліфами, maxResidentPages <= 0 — без обмеження.
+// Статистика сторінок — GlyphPager_GetStats(font.pager, &stats). Стиснутий шрифт завантажується цілим.
+PSF_Font LoadPSFFontPaged(const char* filename, int maxResidentPages);
+
+// Дані гліфа з індексом index для будь-якого способу завантаження (NULL — індекс поза межами).
+// Для посторінкового шрифту з обмеженням вказівник дійсний до наступного виклику.
+const unsigned char* GetPSFGlyph(const PSF_Font* font, int index);
+
+// Необов’язкове перекодування гліфів після завантаження: кожен рядок — одна маска uint64_t
+// (старший біт — лівий піксель), крок гліфа вирівняно на 64 байти. Растеризатори тоді обходять
+// лише встановлені пікселі. Повертає 0 для ширини понад 64 і посторінкових шрифтів.
+int BuildPSFRowMasks(PSF_Font* font);
+
+// Маски рядків гліфа або NULL, якщо їх не побудовано
+const uint64_t* GetPSFGlyphRows(const PSF_Font* font, int index);
+
+// Межі «чорнила» гліфа або NULL, якщо їх не обчислено (посторінковий шрифт).
+// Растеризатори пропускають порожні рядки і не малюють порожні гліфи взагалі.
+const PSF_GlyphBounds* GetPSFGlyphBounds(const PSF_Font* font, int index);
+
+// Необов’язковий розклад гліфів на прямокутники (горизонтальні відрізки, злиті по вертикалі).
+// DrawPSFChar/DrawPSFCharScaled тоді малюють гліф кількома заливками прямокутників, інакше —
+// масками рядків (BuildPSFRowMasks), якщо їх побудовано, або побітово. Повертає 0 для ширини
+// понад 64 і посторінкових чи стиснутих шрифтів.
+int BuildPSFGlyphRects(PSF_Font* font);
+
+// Прямокутники гліфа (*count штук) або NULL, якщо розклад не побудовано
+const PSF_GlyphRect* GetPSFGlyphRects(const PSF_Font* font, int index, int* count);
+
+// Завантаження PSF шрифту з буфера в пам’яті (вбудований шрифт) без копіювання гліфів;
+// буфер має існувати весь час життя шрифту. Виділяються лише Unicode-індекс і межі «чорнила».
+PSF_Font LoadPSFFontFromMemory(const void* data, size_t size);
+
+// Те саме без завершення програми: повертає 1 при успіху, 0 при помилці
+int TryLoadPSFFontFromMemory(const void* data, size_t size, PSF_Font* out);
+
 // Функція звільнення пам’яті, виділеної під шрифт
 void UnloadPSFFont(PSF_Font font);
 
+// Реєстрація обробника звільнення шрифтів (до 8 штук): кеші, прив’язані до font.serial,
+// звільняють свої записи разом зі шрифтом. Повертає 0, якщо місця немає.
+int AddPSFUnloadHook(PSF_UnloadHook hook);
+
+// Реєстрація обробника зміни гліфів при перезавантаженні шрифту (до 8 штук)
+int AddPSFGlyphChangedHook(PSF_GlyphChangedHook hook);
+
+// Заміна даних шрифту на місці новою версією того самого файлу (newFont переходить у власність font).
+// За незмінних розмірів serial зберігається, а обробники отримують лише змінені гліфи;
+// інакше шрифт звільняється повністю. Повертає кількість змінених гліфів.
+int ReloadPSFFontInPlace(PSF_Font* font, PSF_Font newFont);
+
+// Залишає у шрифті лише гліфи, досяжні з Unicode-відповідності (таблиця шрифту або ASCII + cyr_map),
+// щільним масивом: пробіл, цифри, латиниця, решта ASCII, кирилиця, інше. keep (може бути NULL)
+// обмежує набір заданими кодовими точками, решта символів малюється пробілом. Таблиця перебудовується
+// під нові індекси, тож гліфи далі адресуються кодовими точками. Повертає 0 для посторінкового шрифту.
+int CompactPSFFont(PSF_Font* font, const uint32_t* keep, int keepCount);
+
+// LoadPSFFont + CompactPSFFont лише для символів інтерфейсу (ASCII і cyr_map)
+PSF_Font LoadPSFFontCompact(const char* filename);
+
+// Покриття Unicode активною відповідністю шрифту (власна таблиця або вбудована ASCII + cyr_map):
+// кількість кодових точок з гліфом; у *pages (може бути NULL) — біт p для сторінок U+p00..U+pFF (p < 64)
+int GetPSFUnicodeCoverage(const PSF_Font* font, uint64_t* pages);
+
+// Стиснення гліфів у пам’яті для великих шрифтів: спільний словник рядків (найчастіші — однобайтовим кодом)
+// і серії повторів рядків, розпакування гліфа за O(розмір гліфа) в кеш з cacheSlots гліфів (<= 0 — типовий).
+// Рядкові маски й прямокутники звільняються, межі «чорнила» лишаються. Повертає 1 при успіху,
+// 0 — якщо стиснення з кешем не менше за гліфи або шрифт посторінковий (шрифт не змінюється).
+// Статистика — GlyphCompressor_GetStats(font.compressor, &stats).
+int CompressPSFFont(PSF_Font* font, int cacheSlots);
+
+// LoadPSFFont + CompressPSFFont
+PSF_Font LoadPSFFontCompressed(const char* filename, int cacheSlots);
+
+// Копія шрифту з гліфами, повернутими на rotation = 90/180/270 градусів проти годинникової стрілки
+// (стовпці стають рядками, розміри гліфа міняються місцями). Будується при першому зверненні
+// і звільняється разом зі шрифтом. rotation = 0 — сам font, NULL — кут не кратний 90.
+// Індекси гліфів ті самі, що й у font.
+const PSF_Font* GetPSFRotatedFont(const PSF_Font* font, int rotation);
+
+// Стилізована копія шрифту (комбінація PSF_STYLE_*), обчислена один раз на шрифт і стиль
+// порозрядними операціями над рядками гліфів і звільнювана разом зі шрифтом.
+// BOLD і ITALIC змінюють сам гліф; з OUTLINE або SHADOW копія містить лише оздоблення,
+// яке малюється під звичайним текстом. Гліф копії ширший за вихідний і зсунутий
+// на GetPSFStylePadding(style) пікселів вліво-вгору. NULL — гліф стилю ширший за 64 пікселі.
+const PSF_Font* GetPSFStyledFont(const PSF_Font* font, int style);
+int GetPSFStylePadding(int style);
+
+// Індекс гліфа для кодової точки або -1, якщо шрифт його не має: на відміну від малювання тексту,
+// відсутній символ не замінюється пробілом (для ланцюжка запасних шрифтів, див. FontFallback.h)
+int FindPSFGlyph(const PSF_Font* font, uint32_t codepoint);
+
 // Функція для відображення одного символу (гліфа) у позиції (x,y) заданим кольором
 void DrawPSFChar(PSF_Font font, int x, int y, int c, Color color);
 
@@ -30,6 +241,73 @@ void DrawPSFText(PSF_Font font, int x, int y, const char* text, int spacing, Col
 void DrawPSFCharScaled(PSF_Font font, int x, int y, int c, int scale, Color color);
 void DrawPSFTextScaled(PSF_Font font, int x, int y, const char* text, int spacing, int scale, Color color);
 
+// Текст без завершального нуля і без повторного декодування: length байтів UTF-8 (напр. частина
+// буфера, довжину якої повернув snprintf), масив кодових точок UTF-32 (напр. кільцевий буфер
+// журналу) або масив індексів гліфів (PSF_TEXT_NEWLINE — перенос рядка). Розкладка та сама,
+// що й у DrawPSFText / DrawPSFTextScaled; ці варіанти не проходять через кеш розкладок.
+void DrawPSFTextN(PSF_Font font, int x, int y, const char* text, size_t length, int spacing, Color color);
+void DrawPSFTextNScaled(PSF_Font font, int x, int y, const char* text, size_t length, int spacing, int scale, Color color);
+void DrawPSFTextUTF32(PSF_Font font, int x, int y, const uint32_t* codepoints, size_t count, int spacing, Color color);
+void DrawPSFTextUTF32Scaled(PSF_Font font, int x, int y, const uint32_t* codepoints, size_t count, int spacing, int scale, Color color);
+void DrawPSFGlyphs(PSF_Font font, int x, int y, const int32_t* glyphs, size_t count, int spacing, Color color);
+void DrawPSFGlyphsScaled(PSF_Font font, int x, int y, const int32_t* glyphs, size_t count, int spacing, int scale, Color color);
+
+// Текст ланцюжком запасних шрифтів (FontFallback.h): символ, якого немає в основному шрифті,
+// береться з наступного шрифту ланцюжка; пошук пари (шрифт, гліф) кешується для кожної кодової точки
+struct FontFallback;
+void DrawPSFTextFallback(struct FontFallback* fallback, int x, int y, const char* text, int spacing, Color color);
+void DrawPSFTextFallbackScaled(struct FontFallback* fallback, int x, int y, const char* text, int spacing, int scale, Color color);
+
+// Текст, повернутий на rotation = 90/180/270 градусів проти годинникової стрілки навколо (x, y) —
+// лівого верхнього кута тексту до повороту (90 — знизу вгору, для підписів вертикальної осі).
+// Повернуті копії гліфів будуються один раз на шрифт і кут (GetPSFRotatedFont).
+void DrawPSFTextRotated(PSF_Font font, int x, int y, const char* text, int spacing, int rotation, Color color);
+void DrawPSFTextRotatedScaled(PSF_Font font, int x, int y, const char* text, int spacing, int rotation, int scale, Color color);
+
+// Текст стилем PSF_STYLE_* (див. GetPSFStyledFont): один виклик малювання на символ,
+// розкладка та сама, що й у DrawPSFText
+void DrawPSFTextStyled(PSF_Font font, int x, int y, const char* text, int spacing, int style, Color color);
+void DrawPSFTextStyledScaled(PSF_Font font, int x, int y, const char* text, int spacing, int style, int scale, Color color);
+
+// Текст з обведенням/тінню для читабельності поверх осцилограм: оздоблення (OUTLINE/SHADOW зі style)
+// кольором decorationColor під текстом кольору textColor
+void DrawPSFTextDecorated(PSF_Font font, int x, int y, const char* text, int spacing, int style, int scale,
+                          Color textColor, Color decorationColor);
+
+// Пакетне перетворення length байтів UTF-8 в індекси гліфів шрифту font (font == NULL — у кодові
+// точки): не більше capacity елементів, '\n' — PSF_TEXT_NEWLINE, некоректні послідовності
+// замінюються U+FFFD (див. Utf8Decoder.h). Повертає кількість елементів, у *consumed — прочитані байти.
+size_t DecodePSFText(const PSF_Font* font, const char* text, size_t length, int32_t* out, size_t capacity, size_t* consumed);
+
+// Курсор по рядку text (до завершального нуля) для циклів малювання:
+//   InitPSFTextCursor(&cursor, &font, text);
+//   while ((glyph = NextPSFTextItem(&cursor)) != PSF_TEXT_END) { ... }
+void InitPSFTextCursor(PSF_TextCursor* cursor, const PSF_Font* font, const char* text);
+// Те саме для length байтів text без завершального нуля, масиву кодових точок UTF-32
+// ('\n' — перенос рядка) і масиву готових індексів гліфів (PSF_TEXT_NEWLINE — перенос рядка,
+// інші від’ємні значення — пробіл)
+void InitPSFTextCursorN(PSF_TextCursor* cursor, const PSF_Font* font, const char* text, size_t length);
+void InitPSFTextCursorUTF32(PSF_TextCursor* cursor, const PSF_Font* font, const uint32_t* codepoints, size_t count);
+void InitPSFTextCursorGlyphs(PSF_TextCursor* cursor, const int32_t* glyphs, size_t count);
+int NextPSFTextItem(PSF_TextCursor* cursor);
+
+// Підготовлений текст (PSF_PreparedText) для підписів, що малюються щокадру: декодування, пошук
+// гліфів і розкладка — один раз у PreparePSFText, DrawPreparedPSFText лише виводить гліфи.
+// Після CompactPSFFont шрифту текст треба підготувати заново (індекси гліфів змінюються).
+PSF_PreparedText* PreparePSFText(const PSF_Font* font, const char* text, int spacing, int scale);
+void DrawPreparedPSFText(const PSF_PreparedText* text, int x, int y, Color color);
+void FreePreparedPSFText(PSF_PreparedText* text);
+
+// Кеш розкладених рядків для малювання щокадру: DrawPSFText, DrawPSFTextScaled і DrawPSFTextScaledWithInvertedBackground
+// з тим самим рядком, шрифтом, відступом і масштабом беруть готову розкладку замість декодування.
+// GetPSFTextRun повертає розкладку з кешу (або нову, додану до кешу), NULL — рядок не кешується.
+// Розкладкою володіє кеш: вона дійсна до наступного малювання тексту або звільнення шрифту;
+// записи шрифту звільняються з UnloadPSFFont і ReloadPSFFontInPlace. Поле font розкладки з кешу —
+// NULL (кеш тримає лише serial шрифту), тож її гліфи малюються шрифтом, переданим у GetPSFTextRun.
+const PSF_PreparedText* GetPSFTextRun(const PSF_Font* font, const char* text, int spacing, int scale);
+void GetPSFTextRunCacheStats(PSF_TextRunCacheStats* stats);
+void ClearPSFTextRunCache(void);
+
 // Підрахунок кількості UTF-8 символів у рядку
 int utf8_strlen(const char* s);
 
@@ -19,9 +19,12 @@ int main(void) {
 
     InitWindow(screenWidth, screenHeight, "Raylib Oscilloscope with Trigger and Scaling");
 
-    // Завантаження PSF шрифту (шлях до вашого файлу)
-    psfFont = LoadPSFFont("fonts/Uni3-TerminusBold32x16.psf");
-    psfFont12 = LoadPSFFont("fonts/Uni3-Terminus12x6.psf");
+    // Завантаження PSF шрифту (шлях до вашого файлу; у збірці EMBED_FONTS=1 — з пам’яті програми)
+    psfFont = LoadPSFFontEmbedded("fonts/Uni3-TerminusBold32x16.psf");
+    psfFont12 = LoadPSFFontEmbedded("fonts/Uni3-Terminus12x6.psf");
+    // Бекенд заливає прямокутники: гліф малюється кількома заливками замість пікселів
+    BuildPSFGlyphRects(&psfFont);
+    BuildPSFGlyphRects(&psfFont12);
 
     SetTargetFPS(60);
 
@@ -12,6 +12,7 @@
 
 #include "raylib.h"
 #include "psf_font.h"  // заголовок із парсером PSF
+#include "EmbeddedFonts.h" // вбудовані шрифти (make EMBED_FONTS=1)
 
 #endif // MAIN_H
 
@@ -0,0 +1,56 @@
+// AsyncFontLoader.h
+#ifndef ASYNC_FONT_LOADER_H
+#define ASYNC_FONT_LOADER_H
+
+#include "psf_font.h"
+
+// Фонове паралельне завантаження PSF шрифтів.
+// Читання файлу і розбір виконує невеликий пул робочих потоків, а головний потік
+// отримує дескриптори одразу і може показати перший кадр, не чекаючи всіх шрифтів.
+
+// Стан завдання завантаження
+typedef enum {
+    ASYNC_FONT_PENDING = 0, // У черзі або завантажується
+    ASYNC_FONT_READY,       // Шрифт завантажено
+    ASYNC_FONT_FAILED,      // Файл не вдалося відкрити або розібрати
+    ASYNC_FONT_INVALID,     // Невідомий дескриптор
+    ASYNC_FONT_TAKEN        // Шрифт уже передано викликачу (TryGet/Wait)
+} AsyncFontStatus;
+
+// Дескриптор завдання (індекс у межах завантажувача, -1 — помилка)
+typedef int AsyncFontHandle;
+
+typedef struct AsyncFontLoader AsyncFontLoader;
+
+// Створює завантажувач з workerCount потоками (<= 0 — за кількістю ядер, не більше 4).
+// Повертає NULL, якщо не вдалося виділити пам’ять або запустити жоден потік.
+AsyncFontLoader* AsyncFontLoader_Create(int workerCount);
+
+// Ставить у чергу завантаження одного файлу, повертає дескриптор або -1
+AsyncFontHandle AsyncFontLoader_Submit(AsyncFontLoader* loader, const char* filename);
+
+// Ставить у чергу список файлів; дескриптори записуються в handles[0..count-1].
+// Повертає кількість успішно поставлених завдань.
+int AsyncFontLoader_SubmitList(AsyncFontLoader* loader, const char* const* filenames, int count,
+                               AsyncFontHandle* handles);
+
+// Неблокуюча перевірка стану завдання
+AsyncFontStatus AsyncFontLoader_Poll(AsyncFontLoader* loader, AsyncFontHandle handle);
+
+// Неблокуюче отримання шрифту: якщо завдання готове, копіює шрифт у *out
+// і передає його викликачу (далі звільняти через UnloadPSFFont).
+// Повертає стан завдання; *out заповнюється лише при ASYNC_FONT_READY. Шрифт передається
+// один раз: наступні виклики повертають ASYNC_FONT_TAKEN і не змінюють *out.
+AsyncFontStatus AsyncFontLoader_TryGet(AsyncFontLoader* loader, AsyncFontHandle handle, PSF_Font* out);
+
+// Блокуюче очікування завершення завдання; при ASYNC_FONT_READY шрифт передається в *out
+AsyncFontStatus AsyncFontLoader_Wait(AsyncFontLoader* loader, AsyncFontHandle handle, PSF_Font* out);
+
+// Блокуюче очікування всіх поставлених завдань
+void AsyncFontLoader_WaitAll(AsyncFontLoader* loader);
+
+// Зупиняє потоки (дочекавшись поточних завдань) і звільняє шрифти,
+// які так і не були передані викликачу
+void AsyncFontLoader_Destroy(AsyncFontLoader* loader);
+
+#endif // ASYNC_FONT_LOADER_H
@@ -0,0 +1,36 @@
+// FontPackFormat.h
+#ifndef FONT_PACK_FORMAT_H
+#define FONT_PACK_FORMAT_H
+
+// Формат контейнера шрифтів (.psfpack): кілька PSF шрифтів в одному файлі за спільним індексом.
+// Усі числа — little-endian uint32.
+//
+//   0   заголовок    magic "PSFP", version, faceCount, entrySize
+//   16  індекс       faceCount записів по FONT_PACK_ENTRY_SIZE байтів
+//   ... шрифти       оригінальні PSF1/PSF2 файли, кожен вирівняно на FONT_PACK_ALIGN
+//
+// Вирівнювання на сторінку дозволяє відображати пакет одним mmap: сторінки шрифту,
+// до якого ще не зверталися, не читаються з диска. Unicode-таблиця в індексі не описується —
+// завантажувач бере її з самого PSF файлу.
+
+#define FONT_PACK_MAGIC        "PSFP"
+#define FONT_PACK_VERSION      2
+#define FONT_PACK_HEADER_SIZE  16
+#define FONT_PACK_ENTRY_SIZE   56
+#define FONT_PACK_NAME_LEN     32     // Ім’я шрифту з нулем у кінці (ім’я файлу без .psf)
+#define FONT_PACK_ALIGN        4096
+
+// Зсуви полів у записі індексу
+#define FONT_PACK_ENTRY_NAME           0  // char[FONT_PACK_NAME_LEN]
+#define FONT_PACK_ENTRY_WIDTH         32  // Ширина гліфа в пікселях
+#define FONT_PACK_ENTRY_HEIGHT        36  // Висота гліфа в пікселях
+#define FONT_PACK_ENTRY_STYLE         40  // Прапорці FONT_PACK_STYLE_*
+#define FONT_PACK_ENTRY_CHARCOUNT     44  // Кількість гліфів
+#define FONT_PACK_ENTRY_OFFSET        48  // Початок PSF файлу від початку пакета
+#define FONT_PACK_ENTRY_SIZE_BYTES    52  // Розмір PSF файлу
+
+// Стиль шрифту
+#define FONT_PACK_STYLE_REGULAR 0x00
+#define FONT_PACK_STYLE_BOLD    0x01
+
+#endif // FONT_PACK_FORMAT_H
@@ -0,0 +1,43 @@
+// GlyphCompressor.h
+#ifndef GLYPH_COMPRESSOR_H
+#define GLYPH_COMPRESSOR_H
+
+#include <stddef.h>
+
+// Типова кількість комірок кешу розпакованих гліфів (покриває ASCII без колізій)
+#define GLYPH_COMPRESSOR_DEFAULT_CACHE 128
+
+// Стиснуте зберігання гліфів у пам’яті для великих шрифтів, де більшість бітів нульові:
+// унікальні рядки гліфів збираються у спільний словник (найчастіші отримують однобайтові коди),
+// повтори сусідніх рядків кодуються довжиною серії, а порожні рядки внизу гліфа не зберігаються.
+// Розпакування одного гліфа — O(розмір гліфа); недавно розпаковані гліфи лежать у кеші.
+typedef struct GlyphCompressor GlyphCompressor;
+
+// Статистика стиснення і кешу
+typedef struct {
+    size_t rawBytes;          // Розмір гліфів без стиснення (charcount * charsize)
+    size_t compressedBytes;   // Словник рядків + коди гліфів + таблиця зміщень
+    size_t cacheBytes;        // Кеш розпакованих гліфів
+    int dictionaryRows;       // Унікальних рядків у словнику
+    int cacheSlots;           // Комірок кешу
+    unsigned long hits;       // Звернень, обслужених кешем
+    unsigned long decodes;    // Розпакувань гліфів
+} GlyphCompressorStats;
+
+// Стискає charcount гліфів по charsize байтів (height рядків по bytesPerRow байтів).
+// Дані glyphs після створення не потрібні. cacheSlots <= 0 — GLYPH_COMPRESSOR_DEFAULT_CACHE
+// (округлюється вгору до степеня двійки). NULL — якщо бракує пам’яті або гліфи надто високі.
+GlyphCompressor* GlyphCompressor_Create(const unsigned char* glyphs, int charcount, int charsize,
+                                        int bytesPerRow, int height, int cacheSlots);
+
+// Розпакований гліф index (з кешу або щойно розпакований) або NULL для неіснуючого індексу.
+// Вказівник дійсний лише до наступного виклику для цього стискача.
+const unsigned char* GlyphCompressor_GetGlyph(GlyphCompressor* compressor, int index);
+
+// Заповнює статистику
+void GlyphCompressor_GetStats(const GlyphCompressor* compressor, GlyphCompressorStats* stats);
+
+// Звільняє стиснуті гліфи і кеш
+void GlyphCompressor_Free(GlyphCompressor* compressor);
+
+#endif // GLYPH_COMPRESSOR_H
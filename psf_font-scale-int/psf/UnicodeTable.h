@@ -0,0 +1,38 @@
+// UnicodeTable.h
+#ifndef UNICODE_TABLE_H
+#define UNICODE_TABLE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Кількість сторінок по 256 кодових точок, що покривають весь Unicode (0..0x10FFFF)
+#define UNICODE_TABLE_PAGES 0x1100
+
+// Значення комірки, для якої гліфа немає
+#define UNICODE_TABLE_NONE  0xFFFF
+
+// Дворівнева таблиця Unicode → індекс гліфа з прямою адресацією:
+// старші біти кодової точки вибирають сторінку, молодший байт — комірку в ній.
+// Сторінка 0 завжди порожня, на неї вказують усі незаповнені діапазони,
+// тому пошук — це два звернення до пам’яті без циклів і розгалужень.
+typedef struct {
+    uint16_t pageIndex[UNICODE_TABLE_PAGES]; // Номер сторінки для (codepoint >> 8)
+    uint16_t (*pages)[256];                  // Сторінки з індексами гліфів
+    int pageCount;                           // Кількість виділених сторінок (разом з порожньою)
+    int pageCapacity;                        // Місткість масиву pages
+} UnicodeTable;
+
+// Ініціалізація порожньої таблиці
+void UnicodeTable_Init(UnicodeTable* table);
+
+// Звільнення сторінок таблиці
+void UnicodeTable_Free(UnicodeTable* table);
+
+// Додає відповідність codepoint → glyphIndex (перший запис для кодової точки має пріоритет).
+// Повертає 1 при успіху, 0 якщо кодова точка або індекс поза допустимими межами.
+int UnicodeTable_Set(UnicodeTable* table, uint32_t codepoint, int glyphIndex);
+
+// Повертає індекс гліфа або -1, якщо кодова точка відсутня в таблиці
+int UnicodeTable_Get(const UnicodeTable* table, uint32_t codepoint);
+
+#endif // UNICODE_TABLE_H
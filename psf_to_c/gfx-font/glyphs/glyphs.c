@@ -1,29 +1,111 @@
 #include "glyphs.h"
+#include "UnicodeTable.h"
+#include "Utf8Decoder.h"
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
-// Припускається, що виклик utf8_decode замінено зовнішнім оголошенням
-
-int utf8_decode(const char* str, uint32_t* out_codepoint) {
-    unsigned char c = (unsigned char)str[0];
-    if (c < 0x80) {
-        *out_codepoint = c;
-        return 1;
-    } else if ((c & 0xE0) == 0xC0) {
-        *out_codepoint = ((str[0] & 0x1F) << 6) | (str[1] & 0x3F);
-        return 2;
-    } else if ((c & 0xF0) == 0xE0) {
-        *out_codepoint = ((str[0] & 0x0F) << 12) | ((str[1] & 0x3F) << 6) | (str[2] & 0x3F);
-        return 3;
-    } else if ((c & 0xF8) == 0xF0) {
-        *out_codepoint = ((str[0] & 0x07) << 18) | ((str[1] & 0x3F) << 12) |
-        ((str[2] & 0x3F) << 6) | (str[3] & 0x3F);
-        return 4;
+// Кількість символів, що декодуються з UTF-8 за один виклик Utf8Decoder_Decode
+#define TEXT_CHUNK 64
+
+// Максимальна кількість шрифтів з побудованим індексом Unicode → glyph_map
+#define MAX_INDEXED_FONTS 16
+
+// Межі «чорнила» гліфа по вертикалі
+typedef struct {
+    uint16_t firstRow;     // Перший рядок з хоча б одним пікселем
+    uint16_t lastRow;      // Останній такий рядок
+    uint8_t isEmpty;       // 1 — гліф порожній (пробіл)
+} GlyphInkRows;
+
+// Індекс одного шрифту: пряма адресація кодової точки у позицію масиву glyph_map
+// і гліфи, перекодовані в рядкові маски uint64_t (старший біт — лівий піксель)
+typedef struct {
+    const Font* font;
+    UnicodeTable table;
+    uint64_t* rowMasks;    // glyph_count * rowStride масок, вирівняно на 64 байти (NULL — ширина > 64)
+    int rowStride;         // Масок на гліф, кратно 8
+    GlyphInkRows* inkRows; // Перший/останній непорожній рядок кожного гліфа (разом з rowMasks)
+} FontIndexEntry;
+
+static FontIndexEntry g_fontIndex[MAX_INDEXED_FONTS];
+static int g_fontIndexCount = 0;
+
+// Рядок гліфа у вигляді 64-бітової маски: старший біт — лівий піксель, біти за межами ширини обнулено
+static uint64_t PackGlyphRow(const uint8_t* row, int bytes_per_row, int width) {
+    uint64_t mask = 0;
+    for (int b = 0; b < bytes_per_row; b++) {
+        mask |= (uint64_t)row[b] << (56 - 8 * b);
     }
-    *out_codepoint = 0;
-    return 1;
+    return mask & (~0ULL << (64 - width));
+}
+
+// Перекодування всіх гліфів шрифту в рядкові маски з кроком 64 байти
+static void BuildRowMasks(FontIndexEntry* entry, const Font* font) {
+    if (font->char_width <= 0 || font->char_width > 64) return;
+
+    int bytes_per_row = (font->char_width + 7) / 8;
+    int stride = (font->char_height + 7) & ~7;
+    size_t bytes = (size_t)font->glyph_count * stride * sizeof(uint64_t);
+    uint64_t* masks = aligned_alloc(64, bytes ? bytes : 64);
+    GlyphInkRows* ink = calloc(font->glyph_count ? font->glyph_count : 1, sizeof(GlyphInkRows));
+    if (!masks || !ink) {
+        free(masks);
+        free(ink);
+        return;
+    }
+    memset(masks, 0, bytes);
+
+    for (int i = 0; i < font->glyph_count; i++) {
+        const uint8_t* glyph = font->glyph_map[i].glyph;
+        int firstRow = -1, lastRow = -1;
+        for (int row = 0; row < font->char_height; row++) {
+            uint64_t mask = PackGlyphRow(glyph + row * bytes_per_row, bytes_per_row, font->char_width);
+            masks[(size_t)i * stride + row] = mask;
+            if (mask) {
+                if (firstRow < 0) firstRow = row;
+                lastRow = row;
+            }
+        }
+        ink[i].isEmpty = firstRow < 0;
+        ink[i].firstRow = firstRow < 0 ? 0 : (uint16_t)firstRow;
+        ink[i].lastRow = lastRow < 0 ? 0 : (uint16_t)lastRow;
+    }
+    entry->rowMasks = masks;
+    entry->rowStride = stride;
+    entry->inkRows = ink;
+}
+
+// Повертає індекс для шрифту, будуючи його при першому зверненні.
+// NULL — якщо місця під нові індекси немає (тоді пошук лінійний).
+static const FontIndexEntry* GetFontIndex(const Font* font) {
+    for (int i = 0; i < g_fontIndexCount; i++) {
+        if (g_fontIndex[i].font == font) {
+            return &g_fontIndex[i];
+        }
+    }
+
+    if (g_fontIndexCount >= MAX_INDEXED_FONTS) return NULL;
+
+    FontIndexEntry* entry = &g_fontIndex[g_fontIndexCount];
+    UnicodeTable_Init(&entry->table);
+    if (entry->table.pageCount == 0) return NULL;
+    for (int i = 0; i < font->glyph_count; i++) {
+        UnicodeTable_Set(&entry->table, font->glyph_map[i].unicode, i);
+    }
+    BuildRowMasks(entry, font);
+    entry->font = font;
+    g_fontIndexCount++;
+    return entry;
 }
 
 const GlyphPointerMap* Font_FindGlyph(const Font* font, uint32_t unicode) {
+    const FontIndexEntry* index = GetFontIndex(font);
+    if (index) {
+        int i = UnicodeTable_Get(&index->table, unicode);
+        return (i >= 0) ? &font->glyph_map[i] : NULL;
+    }
+
     for (int i = 0; i < font->glyph_count; i++) {
         if (font->glyph_map[i].unicode == unicode) {
             return &font->glyph_map[i];
@@ -32,6 +114,43 @@ const GlyphPointerMap* Font_FindGlyph(const Font* font, uint32_t unicode) {
     return NULL;
 }
 
+// Малювання гліфа з рядкових масок: обходяться лише непорожні рядки і встановлені біти в них
+static void DrawGlyphRows(const uint64_t* rows, int firstRow, int lastRow, int x, int y, int scale,
+                          uint32_t color, void (*DrawPixelFunc)(uint16_t, uint16_t, uint32_t))
+{
+    for (int row = firstRow; row <= lastRow; row++) {
+        uint64_t bits = rows[row];
+        while (bits) {
+            int px = __builtin_clzll(bits);          // Найлівіший встановлений піксель
+            bits &= ~(0x8000000000000000ULL >> px);  // Знімаємо його з маски
+            int draw_x = x + px * scale;
+            int draw_y = y + row * scale;
+            for (int dx = 0; dx < scale; dx++) {
+                for (int dy = 0; dy < scale; dy++) {
+                    DrawPixelFunc(draw_x + dx, draw_y + dy, color);
+                }
+            }
+        }
+    }
+}
+
+// Малювання гліфа через маски з індексу шрифту.
+// Повертає 0, якщо масок немає і гліф треба малювати з байтів.
+static int Font_DrawGlyphRows(const Font* font, const GlyphPointerMap* glyph, int x, int y, int scale,
+                              uint32_t color, void (*DrawPixelFunc)(uint16_t, uint16_t, uint32_t))
+{
+    const FontIndexEntry* index = GetFontIndex(font);
+    if (!index || !index->rowMasks) return 0;
+
+    size_t i = (size_t)(glyph - font->glyph_map);
+    const GlyphInkRows* ink = &index->inkRows[i];
+    if (!ink->isEmpty) {  // Порожній гліф (пробіл) не малюємо взагалі
+        DrawGlyphRows(index->rowMasks + i * index->rowStride, ink->firstRow, ink->lastRow,
+                      x, y, scale, color, DrawPixelFunc);
+    }
+    return 1;
+}
+
 void DrawGlyph(const uint8_t* glyph, int charsize, int width, int height,
                uint16_t x, uint16_t y, uint32_t color)
 {
@@ -83,6 +202,7 @@ void Font_DrawChar(const Font* font, uint32_t codepoint,
 {
     const GlyphPointerMap* glyph = Font_FindGlyph(font, codepoint);
     if (!glyph) return;
+    if (Font_DrawGlyphRows(font, glyph, x, y, 1, color, DrawPixel)) return;
     DrawGlyph(glyph->glyph, font->char_bytes, font->char_width, font->char_height,
               x, y, color);
 }
@@ -92,23 +212,27 @@ void Font_DrawTextScaled(const Font* font, const char* text,
                          void (*DrawPixelFunc)(uint16_t, uint16_t, uint32_t)) {
     int xpos = x;
     int ypos = y;
-    while (*text) {
-        if (*text == '\n'){
-            xpos = x;
-            ypos += (font->char_height * scale) + spacing;
-            text++;
-            continue;
-        }
-        uint32_t codepoint = 0;
-        int bytes = utf8_decode(text, &codepoint);
-        const GlyphPointerMap* glyph = Font_FindGlyph(font, codepoint);
-        if (!glyph) glyph = Font_FindGlyph(font, 32);
-        if (glyph) {
-            DrawGlyphScaled(glyph->glyph, font->char_width, font->char_height, font->char_bytes,
-                            xpos, ypos, scale, color, DrawPixelFunc);
+    size_t remaining = strlen(text);
+    uint32_t codepoints[TEXT_CHUNK];   // Порція тексту; некоректні послідовності — U+FFFD
+    while (remaining > 0) {
+        size_t consumed = 0;
+        size_t count = Utf8Decoder_Decode(text, remaining, codepoints, TEXT_CHUNK, &consumed);
+        text += consumed;
+        remaining -= consumed;
+        for (size_t i = 0; i < count; i++) {
+            if (codepoints[i] == '\n') {
+                xpos = x;
+                ypos += (font->char_height * scale) + spacing;
+                continue;
+            }
+            const GlyphPointerMap* glyph = Font_FindGlyph(font, codepoints[i]);
+            if (!glyph) glyph = Font_FindGlyph(font, 32);
+            if (glyph && !Font_DrawGlyphRows(font, glyph, xpos, ypos, scale, color, DrawPixelFunc)) {
+                DrawGlyphScaled(glyph->glyph, font->char_width, font->char_height, font->char_bytes,
+                                xpos, ypos, scale, color, DrawPixelFunc);
+            }
+            xpos += (font->char_width * scale) + spacing;
         }
-        xpos += (font->char_width * scale) + spacing;
-        text += bytes;
     }
 }
 
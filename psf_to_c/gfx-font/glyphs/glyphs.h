@@ -6,8 +6,6 @@
 
 extern void DrawPixel(uint16_t x, uint16_t y, uint32_t color);
 
-int utf8_decode(const char* str, uint32_t* out_codepoint);
-
 const GlyphPointerMap* Font_FindGlyph(const Font* font, uint32_t unicode);
 
 void DrawGlyph(const uint8_t* glyph, int charsize, int width, int height,
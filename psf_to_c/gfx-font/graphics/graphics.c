@@ -161,13 +161,12 @@ void DrawLineEx(Vector2 startPos, Vector2 endPos, float thickness, uint32_t colo
 }
 
 // Малювання заповненого прямокутника кольором color (у форматі 0xRRGGBB)
+// одним запитом до X-сервера замість окремої точки на кожен піксель
 void DrawRectangle(int16_t x, int16_t y, int16_t width, int16_t height, uint32_t color)
 {
-    for (int16_t py = y; py < y + height; py++) {
-        for (int16_t px = x; px < x + width; px++) {
-            DrawPixel(px, py, color);
-        }
-    }
+    if (width <= 0 || height <= 0) return;
+    gfx_color((color >> 16) & 0xFF, (color >> 8) & 0xFF, color & 0xFF);
+    gfx_fill_rect(x, y, width, height);
 }
 
 // Малювання не заповненого прямокутника кольором color (у форматі 0xRRGGBB)
@@ -0,0 +1,176 @@
+// psf_pack.c
+// Пакувальник PSF шрифтів у єдиний контейнер .psfpack (формат описано у FontPackFormat.h)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "FontPackFormat.h"
+
+// Шрифт, підготовлений до запису в пакет
+typedef struct {
+    char name[FONT_PACK_NAME_LEN];
+    unsigned char* data;     // Увесь PSF файл
+    uint32_t size;
+    uint32_t width, height, style, charcount;
+    uint32_t offset;         // Від початку пакета (заповнюється при розкладці)
+} PackFace;
+
+static uint32_t ReadLE32(const unsigned char* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void WriteLE32(unsigned char* p, uint32_t v) {
+    p[0] = v & 0xFF;
+    p[1] = (v >> 8) & 0xFF;
+    p[2] = (v >> 16) & 0xFF;
+    p[3] = (v >> 24) & 0xFF;
+}
+
+// Ім’я шрифту з шляху до файлу (без каталогу і розширення)
+static void GetFontName(const char* filepath, char* fontname, size_t max_len) {
+    const char* slash = strrchr(filepath, '/');
+    if (!slash)
+        slash = strrchr(filepath, '\\');
+    const char* start = slash ? slash + 1 : filepath;
+    const char* dot = strrchr(start, '.');
+    size_t len = dot ? (size_t)(dot - start) : strlen(start);
+    if (len >= max_len) len = max_len - 1;
+    memcpy(fontname, start, len);
+    fontname[len] = '\0';
+}
+
+// Читання PSF файлу цілком і розбір заголовка. Повертає 1 при успіху.
+static int ReadFace(const char* filename, PackFace* face) {
+    FILE* f = fopen(filename, "rb");
+    if (!f) {
+        printf("Не вдалося відкрити файл шрифту: %s\n", filename);
+        return 0;
+    }
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    if (size < 4) {
+        fclose(f);
+        printf("Файл шрифту занадто малий: %s\n", filename);
+        return 0;
+    }
+
+    memset(face, 0, sizeof(*face));
+    face->data = malloc((size_t)size);
+    if (!face->data || fread(face->data, 1, (size_t)size, f) != (size_t)size) {
+        fclose(f);
+        free(face->data);
+        printf("Не вдалося прочитати файл шрифту: %s\n", filename);
+        return 0;
+    }
+    fclose(f);
+    face->size = (uint32_t)size;
+
+    const unsigned char* d = face->data;
+    uint32_t glyphOffset, charsize;
+    if (d[0] == 0x36 && d[1] == 0x04) {
+        // PSF1: 8 пікселів завширшки, висота = розмір гліфа
+        face->width = 8;
+        face->height = d[3];
+        face->charcount = (d[2] & 0x01) ? 512 : 256;
+        charsize = d[3];
+        glyphOffset = 4;
+    }
+    else if (size >= 32 && d[0] == 0x72 && d[1] == 0xB5 && d[2] == 0x4A && d[3] == 0x86) {
+        glyphOffset = ReadLE32(d + 8);
+        face->charcount = ReadLE32(d + 16);
+        charsize = ReadLE32(d + 20);
+        face->height = ReadLE32(d + 24);
+        face->width = ReadLE32(d + 28);
+    }
+    else {
+        printf("Формат шрифту не підтримується: %s\n", filename);
+        free(face->data);
+        return 0;
+    }
+
+    uint64_t glyphEnd = (uint64_t)glyphOffset + (uint64_t)face->charcount * charsize;
+    if (glyphEnd > face->size) {
+        printf("Файл шрифту обрізано: %s\n", filename);
+        free(face->data);
+        return 0;
+    }
+
+    GetFontName(filename, face->name, sizeof(face->name));
+    face->style = strstr(face->name, "Bold") ? FONT_PACK_STYLE_BOLD : FONT_PACK_STYLE_REGULAR;
+    return 1;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        printf("Використання: %s output.psfpack font1.psf [font2.psf ...]\n", argv[0]);
+        return 1;
+    }
+
+    int faceCount = argc - 2;
+    PackFace* faces = calloc(faceCount, sizeof(PackFace));
+    if (!faces) return 1;
+
+    // Розкладка: заголовок, індекс, далі шрифти з вирівнюванням на сторінку
+    uint32_t offset = FONT_PACK_HEADER_SIZE + faceCount * FONT_PACK_ENTRY_SIZE;
+    for (int i = 0; i < faceCount; i++) {
+        if (!ReadFace(argv[i + 2], &faces[i])) return 1;
+        offset = (offset + FONT_PACK_ALIGN - 1) & ~(uint32_t)(FONT_PACK_ALIGN - 1);
+        faces[i].offset = offset;
+        offset += faces[i].size;
+    }
+
+    FILE* out = fopen(argv[1], "wb");
+    if (!out) {
+        printf("Не вдалося відкрити файл для запису: %s\n", argv[1]);
+        return 1;
+    }
+
+    unsigned char header[FONT_PACK_HEADER_SIZE];
+    memcpy(header, FONT_PACK_MAGIC, 4);
+    WriteLE32(header + 4, FONT_PACK_VERSION);
+    WriteLE32(header + 8, (uint32_t)faceCount);
+    WriteLE32(header + 12, FONT_PACK_ENTRY_SIZE);
+    // Кожен запис перевіряється: неповний пакет (диск заповнено, помилка вводу-виводу) видаляється
+    int ok = fwrite(header, 1, sizeof(header), out) == sizeof(header);
+
+    for (int i = 0; i < faceCount; i++) {
+        const PackFace* face = &faces[i];
+        unsigned char entry[FONT_PACK_ENTRY_SIZE] = {0};
+        memcpy(entry + FONT_PACK_ENTRY_NAME, face->name, strlen(face->name));
+        WriteLE32(entry + FONT_PACK_ENTRY_WIDTH, face->width);
+        WriteLE32(entry + FONT_PACK_ENTRY_HEIGHT, face->height);
+        WriteLE32(entry + FONT_PACK_ENTRY_STYLE, face->style);
+        WriteLE32(entry + FONT_PACK_ENTRY_CHARCOUNT, face->charcount);
+        WriteLE32(entry + FONT_PACK_ENTRY_OFFSET, face->offset);
+        WriteLE32(entry + FONT_PACK_ENTRY_SIZE_BYTES, face->size);
+        if (ok) ok = fwrite(entry, 1, sizeof(entry), out) == sizeof(entry);
+    }
+
+    for (int i = 0; i < faceCount; i++) {
+        // Доповнюємо нулями до вирівняного початку шрифту
+        long pos = ok ? ftell(out) : -1;
+        if (pos < 0) ok = 0;
+        while (ok && pos < (long)faces[i].offset) {
+            ok = fputc(0, out) != EOF;
+            pos++;
+        }
+        if (ok) ok = fwrite(faces[i].data, 1, faces[i].size, out) == faces[i].size;
+        if (ok) {
+            printf("%-32s %2ux%-2u %s  %u байт\n", faces[i].name, faces[i].width, faces[i].height,
+                   faces[i].style ? "bold   " : "regular", faces[i].size);
+        }
+        free(faces[i].data);
+    }
+
+    if (fclose(out) != 0) ok = 0;
+    free(faces);
+    if (!ok) {
+        printf("Помилка запису, пакет не створено: %s\n", argv[1]);
+        remove(argv[1]);
+        return 1;
+    }
+    printf("Записано %d шрифт(ів) у %s (%u байт)\n", faceCount, argv[1], offset);
+    return 0;
+}
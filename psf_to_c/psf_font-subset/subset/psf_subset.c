@@ -0,0 +1,143 @@
+// psf_subset.c
+// Підмножина PSF шрифту за корпусом рядків інтерфейсу: у вихідний PSF2 потрапляють лише гліфи
+// символів, що справді зустрічаються в текстах, з перебудованою Unicode-таблицею.
+// Той самий запис без корпусу (SavePSFFont) перетворює PSF1 у PSF2.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "psf_font.h"
+#include "Utf8Decoder.h"
+
+// Утиліта нічого не малює: вивід графічної бібліотеки не потрібен
+void DrawPixel(uint16_t x, uint16_t y, uint32_t color) {
+    (void)x; (void)y; (void)color;
+}
+
+void DrawRectangle(int16_t x, int16_t y, int16_t width, int16_t height, uint32_t color) {
+    (void)x; (void)y; (void)width; (void)height; (void)color;
+}
+
+// Множина кодових точок корпусу: бітова карта всього Unicode (136 КБ)
+#define CODEPOINT_LIMIT 0x110000
+static uint8_t g_used[CODEPOINT_LIMIT / 8];
+
+static void MarkCodepoint(uint32_t codepoint) {
+    if (codepoint < CODEPOINT_LIMIT) g_used[codepoint >> 3] |= (uint8_t)(1 << (codepoint & 7));
+}
+
+// Довжина блоку без обрізаного межею символу в кінці: його байти дочитуються з наступним блоком
+static size_t CompletePrefix(const unsigned char* s, size_t size) {
+    for (size_t back = 1; back <= 3 && back <= size; back++) {
+        unsigned char c = s[size - back];
+        if ((c & 0xC0) == 0x80) continue;   // Байт продовження — шукаємо початок символу
+        size_t need = c >= 0xF0 ? 4 : c >= 0xE0 ? 3 : c >= 0xC0 ? 2 : 1;
+        return need > back ? size - back : size;
+    }
+    return size;
+}
+
+// Додає всі символи файлу корпусу (UTF-8) до множини. Повертає кількість символів або -1.
+static long ReadCorpus(const char* filename) {
+    FILE* f = fopen(filename, "rb");
+    if (!f) {
+        printf("Не вдалося відкрити файл корпусу: %s\n", filename);
+        return -1;
+    }
+
+    unsigned char buffer[65536 + 4];
+    uint32_t codepoints[4096];
+    size_t pending = 0;   // Незавершений символ з кінця попереднього блоку
+    long chars = 0;
+    for (;;) {
+        size_t n = fread(buffer + pending, 1, 65536, f);
+        size_t size = pending + n;
+        // Перевірку коректності робить Utf8Decoder (некоректне — U+FFFD); обрізаний у кінці файлу
+        // символ теж стає U+FFFD
+        size_t length = n > 0 ? CompletePrefix(buffer, size) : size;
+        size_t i = 0;
+        while (i < length) {
+            size_t consumed = 0;
+            size_t count = Utf8Decoder_Decode((const char*)buffer + i, length - i, codepoints,
+                                              sizeof(codepoints) / sizeof(codepoints[0]), &consumed);
+            for (size_t k = 0; k < count; k++) {
+                // Керівні символи (переведення рядка, табуляція) гліфів не потребують
+                if (codepoints[k] >= 0x20 && codepoints[k] != 0x7F) MarkCodepoint(codepoints[k]);
+            }
+            chars += (long)count;
+            i += consumed;
+        }
+        pending = size - i;
+        memmove(buffer, buffer + i, pending);
+        if (n == 0) break;
+    }
+    fclose(f);
+    return chars;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        printf("Використання: %s input.psf output.psf [corpus1.txt ...]\n", argv[0]);
+        printf("Без файлів корпусу шрифт лише перетворюється у PSF2 з Unicode-таблицею.\n");
+        return 1;
+    }
+
+    PSF_Font font;
+    if (!TryLoadPSFFont(argv[1], &font)) return 1;
+    int sourceGlyphs = font.charcount;
+
+    if (argc > 3) {
+        // Пробіл потрібен завжди: це запасний гліф для символів, яких немає у шрифті
+        MarkCodepoint(' ');
+        for (int i = 3; i < argc; i++) {
+            if (ReadCorpus(argv[i]) < 0) {
+                UnloadPSFFont(font);
+                return 1;
+            }
+        }
+
+        int keepCount = 0;
+        for (uint32_t cp = 0; cp < CODEPOINT_LIMIT; cp++) {
+            if (g_used[cp >> 3] & (1 << (cp & 7))) keepCount++;
+        }
+        uint32_t* keep = (uint32_t*)malloc((size_t)keepCount * sizeof(uint32_t));
+        if (!keep) {
+            printf("Недостатньо пам’яті\n");
+            UnloadPSFFont(font);
+            return 1;
+        }
+        keepCount = 0;
+        for (uint32_t cp = 0; cp < CODEPOINT_LIMIT; cp++) {
+            if (g_used[cp >> 3] & (1 << (cp & 7))) keep[keepCount++] = cp;
+        }
+
+        if (!CompactPSFFont(&font, keep, keepCount)) {
+            printf("Не вдалося вибрати гліфи корпусу зі шрифту: %s\n", argv[1]);
+            free(keep);
+            UnloadPSFFont(font);
+            return 1;
+        }
+
+        // Символи корпусу, яких немає у шрифті (малюватимуться запасним гліфом)
+        int missing = 0;
+        for (int i = 0; i < keepCount; i++) {
+            if (UnicodeTable_Get(font.unicodeTable, keep[i]) >= 0) continue;
+            if (missing < 16) printf("Немає гліфа для U+%04X\n", keep[i]);
+            missing++;
+        }
+        if (missing > 16) printf("... і ще %d символів без гліфа\n", missing - 16);
+        printf("Символів у корпусі: %d, без гліфа: %d\n", keepCount, missing);
+        free(keep);
+    }
+
+    if (!SavePSFFont(&font, argv[2])) {
+        UnloadPSFFont(font);
+        return 1;
+    }
+    printf("%s: %dx%d, гліфів %d -> %d, %zu -> %zu байт гліфів\n", argv[2], font.width, font.height,
+           sourceGlyphs, font.charcount, (size_t)sourceGlyphs * font.charsize,
+           (size_t)font.charcount * font.charsize);
+    UnloadPSFFont(font);
+    return 0;
+}